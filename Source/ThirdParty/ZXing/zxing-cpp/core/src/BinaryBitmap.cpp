@@ -6,6 +6,7 @@
 #include "BinaryBitmap.h"
 
 #include "BitMatrix.h"
+#include "DecodeStatsSink.h"
 
 #include <mutex>
 
@@ -53,10 +54,22 @@ BinaryBitmap::~BinaryBitmap() = default;
 
 const BitMatrix* BinaryBitmap::getBitMatrix() const
 {
-	std::call_once(_cache->once, [&](){_cache->matrix = getBlackMatrix();});
+	std::call_once(_cache->once, [&]() {
+		ZX_STATS_TIMER(Binarization);
+		_cache->matrix = getBlackMatrix();
+	});
 	return _cache->matrix.get();
 }
 
+bool BinaryBitmap::getSubPixelPatternRow(int row, int rotation, int scale, PatternRow& res) const
+{
+	if (!getPatternRow(row, rotation, res))
+		return false;
+	for (auto& width : res)
+		width *= scale;
+	return true;
+}
+
 void BinaryBitmap::invert()
 {
 	if (_cache->matrix) {
@@ -54,6 +54,13 @@ public:
 	*/
 	virtual bool getPatternRow(int row, int rotation, PatternRow& res) const = 0;
 
+	/**
+	* Like getPatternRow() but with the widths given in units of 1/scale pixels. This default implementation simply
+	* scales the integer widths, binarizers with access to the luminance values estimate the edges with sub-pixel
+	* precision. The width of the row times scale must not exceed the range of PatternType.
+	*/
+	virtual bool getSubPixelPatternRow(int row, int rotation, int scale, PatternRow& res) const;
+
 	const BitMatrix* getBitMatrix() const;
 
 	void invert();
@@ -58,6 +58,7 @@ class DecodeHints
 	bool _validateITFCheckSum      : 1;
 	bool _returnCodabarStartEnd    : 1;
 	bool _returnErrors             : 1;
+	bool _subPixelEdges            : 1;
 	uint8_t _downscaleFactor       : 3;
 	EanAddOnSymbol _eanAddOnSymbol : 2;
 	Binarizer _binarizer           : 2;
@@ -69,6 +70,8 @@ class DecodeHints
 
 	uint8_t _minLineCount        = 2;
 	uint8_t _maxNumberOfSymbols  = 0xff;
+	uint8_t _maxNumberOfThreads  = 1;
+	uint8_t _scanLineAngles      = 0;
 	uint16_t _downscaleThreshold = 500;
 	BarcodeFormats _formats      = BarcodeFormat::None;
 
@@ -85,6 +88,7 @@ public:
 		  _validateITFCheckSum(0),
 		  _returnCodabarStartEnd(0),
 		  _returnErrors(0),
+		  _subPixelEdges(0),
 		  _downscaleFactor(3),
 		  _eanAddOnSymbol(EanAddOnSymbol::Ignore),
 		  _binarizer(Binarizer::LocalAverage),
@@ -141,6 +145,19 @@ public:
 	/// The maximum number of symbols (barcodes) to detect / look for in the image with ReadBarcodes
 	ZX_PROPERTY(uint8_t, maxNumberOfSymbols, setMaxNumberOfSymbols)
 
+	/// The maximum number of threads a single ReadBarcodes call may use internally (e.g. for the QR Code finder pattern
+	/// search or the row scanning of the linear reader in large images), 0 means one per hardware thread, the default is 1
+	ZX_PROPERTY(uint8_t, maxNumberOfThreads, setMaxNumberOfThreads)
+
+	/// The number of angles between the horizontal and vertical scan lines the linear reader additionally scans along, in
+	/// both directions. They are evenly spaced, e.g. 2 means 30 and 60 degrees (and 120 and 150). The default is 0.
+	ZX_PROPERTY(uint8_t, scanLineAngles, setScanLineAngles)
+
+	/// Estimate the edges in linear symbols with sub-pixel precision from the luminance values. This helps with dense
+	/// symbols of about 1 to 1.5 pixels per module (only with the GlobalHistogram and LocalAverage binarizer). Rows
+	/// (or columns) longer than 16383 pixels are read without it.
+	ZX_PROPERTY(bool, subPixelEdges, setSubPixelEdges)
+
 	/// If true, the Code-39 reader will try to read extended mode.
 	ZX_PROPERTY(bool, tryCode39ExtendedMode, setTryCode39ExtendedMode)
 
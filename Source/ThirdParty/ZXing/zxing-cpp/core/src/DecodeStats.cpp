@@ -0,0 +1,164 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "DecodeStats.h"
+
+#include "DecodeStatsSink.h"
+#include "ZXAlgorithms.h"
+
+namespace ZXing {
+
+int64_t DecodeStats::nanoseconds(Stage stage) const
+{
+	return Reduce(_entries, int64_t(0), [stage](int64_t sum, const Entry& e) { return sum + e.nanoseconds[static_cast<int>(stage)]; });
+}
+
+int64_t DecodeStats::nanoseconds(Stage stage, BarcodeFormats formats) const
+{
+	int64_t res = 0;
+	for (auto& e : _entries)
+		if (e.formats.testFlags(formats))
+			res += e.nanoseconds[static_cast<int>(stage)];
+	return res;
+}
+
+int64_t DecodeStats::binarizationNanoseconds(int layer) const
+{
+	return layer >= 0 && layer < numberOfLayers() ? _binarizationPerLayer[layer] : 0;
+}
+
+void DecodeStats::reset()
+{
+	*this = {};
+}
+
+DecodeStats& DecodeStats::operator+=(const DecodeStats& other)
+{
+	for (auto& e : other._entries)
+		for (int i = 0; i < NumStages; ++i)
+			add(Stage(i), e.formats, e.nanoseconds[i]);
+	for (int i = 0; i < NumCounters; ++i)
+		_counters[i] += other._counters[i];
+	for (int i = 0; i < other.numberOfLayers(); ++i)
+		addBinarization(i, other._binarizationPerLayer[i]);
+	return *this;
+}
+
+void DecodeStats::add(Stage stage, BarcodeFormats formats, int64_t ns)
+{
+	auto i = FindIf(_entries, [formats](const Entry& e) { return e.formats == formats; });
+	if (i == _entries.end())
+		i = _entries.insert(i, {formats, {}});
+	i->nanoseconds[static_cast<int>(stage)] += ns;
+}
+
+void DecodeStats::addBinarization(int layer, int64_t ns)
+{
+	if (layer >= numberOfLayers())
+		_binarizationPerLayer.resize(layer + 1, 0);
+	_binarizationPerLayer[layer] += ns;
+}
+
+bool DecodeStats::IsEnabled()
+{
+#ifdef ZXING_BUILD_DECODE_STATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::string ToString(DecodeStats::Stage stage)
+{
+	constexpr const char* names[] = {"LumExtraction", "Pyramid", "Binarization", "Detection", "Decoding"};
+	return names[static_cast<int>(stage)];
+}
+
+std::string ToString(DecodeStats::Counter counter)
+{
+	constexpr const char* names[] = {"FinderPatternCandidates", "FinderPatternSetsSampled", "GridSampleRejections",
+									 "ReedSolomonFailures", "RowsScanned"};
+	return names[static_cast<int>(counter)];
+}
+
+#ifdef ZXING_BUILD_DECODE_STATS
+
+namespace {
+
+struct ThreadState
+{
+	DecodeStats* stats = nullptr;
+	BarcodeFormats formats;
+	DecodeStatsTimer* timer = nullptr;
+	int layer = 0;
+};
+
+thread_local ThreadState current;
+
+} // namespace
+
+DecodeStatsSink::DecodeStatsSink(DecodeStats* stats)
+	: _stats(current.stats), _formats(current.formats), _timer(current.timer), _layer(current.layer)
+{
+	current = {stats, {}, nullptr, 0};
+}
+
+DecodeStatsSink::~DecodeStatsSink()
+{
+	current = {_stats, _formats, _timer, _layer};
+}
+
+void DecodeStatsSink::count(DecodeStats::Counter counter, int64_t n)
+{
+	if (current.stats)
+		current.stats->add(counter, n);
+}
+
+DecodeStatsFormats::DecodeStatsFormats(BarcodeFormats formats) : _previous(current.formats)
+{
+	current.formats = formats;
+}
+
+DecodeStatsFormats::~DecodeStatsFormats()
+{
+	current.formats = _previous;
+}
+
+DecodeStatsLayer::DecodeStatsLayer(int layer) : _previous(current.layer)
+{
+	current.layer = layer;
+}
+
+DecodeStatsLayer::~DecodeStatsLayer()
+{
+	current.layer = _previous;
+}
+
+DecodeStatsTimer::DecodeStatsTimer(DecodeStats::Stage stage) : _stage(stage)
+{
+	if (!current.stats)
+		return;
+	_active = true;
+	_parent = current.timer;
+	current.timer = this;
+	_start = std::chrono::steady_clock::now();
+}
+
+DecodeStatsTimer::~DecodeStatsTimer()
+{
+	if (!_active)
+		return;
+	int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+	current.stats->add(_stage, current.formats, elapsed - _nested);
+	if (_stage == DecodeStats::Stage::Binarization)
+		current.stats->addBinarization(current.layer, elapsed - _nested);
+	if (_parent)
+		_parent->_nested += elapsed;
+	current.timer = _parent;
+}
+
+#endif
+
+} // ZXing
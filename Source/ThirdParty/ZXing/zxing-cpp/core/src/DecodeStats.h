@@ -0,0 +1,100 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BarcodeFormat.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ZXing {
+
+/**
+ * @brief The DecodeStats class collects per-stage timings and counters of the decoding process.
+ *
+ * Pass an instance to ReadBarcodes (or ReadBarcodesBatch via BatchStats) to find out where the time goes and to tune
+ * the DecodeHints for a given camera setup. The values are accumulated over all calls the same object is passed to.
+ *
+ * The instrumentation is only compiled in if the library has been built with the CMake option BUILD_DECODE_STATS,
+ * otherwise it costs nothing and all values stay 0 (see IsEnabled()).
+ *
+ * The Binarization time is additionally broken down by the pyramid layer it has been spent on.
+ *
+ * The times are exclusive, i.e. the time spent in binarization that got triggered by a detector is not counted as
+ * detection time. The Detection and Decoding stages are attributed to the formats of the reader that was running.
+ * The linear reader handles all linear formats at once and decodes while scanning a row, so its time is reported as
+ * Decoding of all requested linear formats. If it scans its rows with more than one thread (see
+ * DecodeHints::maxNumberOfThreads), the binarization of those rows is included in Decoding as well.
+ */
+class DecodeStats
+{
+public:
+	enum class Stage
+	{
+		LumExtraction, ///< conversion of the input into a dense luminance image
+		Pyramid,       ///< creation of the downscaled layers (see DecodeHints::tryDownscale)
+		Binarization,  ///< BitMatrix creation and pattern row extraction
+		Detection,     ///< symbol detection, including finder pattern search and grid sampling
+		Decoding,      ///< bit stream decoding including error correction
+	};
+	static constexpr int NumStages = 5;
+
+	enum class Counter
+	{
+		FinderPatternCandidates, ///< number of QR Code finder pattern candidates
+		FinderPatternSetsSampled, ///< number of QR Code finder pattern sets that got sampled
+		GridSampleRejections,    ///< number of grids that could not be sampled because they left the image
+		ReedSolomonFailures,     ///< number of uncorrectable Reed-Solomon code words
+		RowsScanned,             ///< number of image rows scanned by the linear reader
+	};
+	static constexpr int NumCounters = 5;
+
+	/// Total time in nanoseconds spent in stage
+	int64_t nanoseconds(Stage stage) const;
+
+	/// Time in nanoseconds spent in stage by the readers of (any of) the given formats
+	int64_t nanoseconds(Stage stage, BarcodeFormats formats) const;
+
+	/// Time in nanoseconds spent in binarization of the given pyramid layer, 0 is the full resolution image
+	int64_t binarizationNanoseconds(int layer) const;
+
+	/// Number of pyramid layers with a recorded binarization time (see DecodeHints::tryDownscale)
+	int numberOfLayers() const { return static_cast<int>(_binarizationPerLayer.size()); }
+
+	int64_t count(Counter counter) const { return _counters[static_cast<int>(counter)]; }
+
+	void reset();
+
+	DecodeStats& operator+=(const DecodeStats& other);
+
+	/// Returns true if the library has been built with BUILD_DECODE_STATS
+	static bool IsEnabled();
+
+private:
+	struct Entry
+	{
+		BarcodeFormats formats;
+		std::array<int64_t, NumStages> nanoseconds = {};
+	};
+
+	std::vector<Entry> _entries; // one per reader (combination of formats)
+	std::array<int64_t, NumCounters> _counters = {};
+	std::vector<int64_t> _binarizationPerLayer;
+
+	void add(Stage stage, BarcodeFormats formats, int64_t ns);
+	void addBinarization(int layer, int64_t ns);
+	void add(Counter counter, int64_t n) { _counters[static_cast<int>(counter)] += n; }
+
+	friend class DecodeStatsTimer;
+	friend class DecodeStatsSink;
+};
+
+std::string ToString(DecodeStats::Stage stage);
+std::string ToString(DecodeStats::Counter counter);
+
+} // ZXing
@@ -0,0 +1,92 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "DecodeStats.h"
+
+// Instrumentation macros for DecodeStats. Unless the library is built with ZXING_BUILD_DECODE_STATS (CMake option
+// BUILD_DECODE_STATS) they expand to nothing. Otherwise they record into the DecodeStats object that has been
+// installed as the sink of the current thread (if any) via ZX_STATS_SINK.
+#ifdef ZXING_BUILD_DECODE_STATS
+
+#include <chrono>
+
+namespace ZXing {
+
+class DecodeStatsTimer;
+
+class DecodeStatsSink
+{
+	DecodeStats* _stats;
+	BarcodeFormats _formats;
+	DecodeStatsTimer* _timer;
+	int _layer;
+
+public:
+	// installs stats as the sink of the current thread for the lifetime of this object, nullptr disables recording
+	explicit DecodeStatsSink(DecodeStats* stats);
+	~DecodeStatsSink();
+
+	DecodeStatsSink(const DecodeStatsSink&) = delete;
+	DecodeStatsSink& operator=(const DecodeStatsSink&) = delete;
+
+	static void count(DecodeStats::Counter counter, int64_t n);
+};
+
+// attributes all stage times recorded during the lifetime of this object to formats
+class DecodeStatsFormats
+{
+	BarcodeFormats _previous;
+
+public:
+	explicit DecodeStatsFormats(BarcodeFormats formats);
+	~DecodeStatsFormats();
+};
+
+// attributes all Binarization times recorded during the lifetime of this object to the pyramid layer
+class DecodeStatsLayer
+{
+	int _previous;
+
+public:
+	explicit DecodeStatsLayer(int layer);
+	~DecodeStatsLayer();
+};
+
+// measures the time until destruction minus the time of nested timers
+class DecodeStatsTimer
+{
+	DecodeStats::Stage _stage;
+	DecodeStatsTimer* _parent = nullptr;
+	bool _active = false;
+	int64_t _nested = 0;
+	std::chrono::steady_clock::time_point _start;
+
+public:
+	explicit DecodeStatsTimer(DecodeStats::Stage stage);
+	~DecodeStatsTimer();
+
+	DecodeStatsTimer(const DecodeStatsTimer&) = delete;
+	DecodeStatsTimer& operator=(const DecodeStatsTimer&) = delete;
+};
+
+} // ZXing
+
+#define ZX_STATS_SINK(stats) ZXing::DecodeStatsSink zx_stats_sink_(stats)
+#define ZX_STATS_FORMATS(formats) ZXing::DecodeStatsFormats zx_stats_formats_(formats)
+#define ZX_STATS_LAYER(layer) ZXing::DecodeStatsLayer zx_stats_layer_(layer)
+#define ZX_STATS_TIMER(stage) ZXing::DecodeStatsTimer zx_stats_timer_(ZXing::DecodeStats::Stage::stage)
+#define ZX_STATS_COUNT(counter, n) ZXing::DecodeStatsSink::count(ZXing::DecodeStats::Counter::counter, n)
+
+#else
+
+#define ZX_STATS_SINK(stats)
+#define ZX_STATS_FORMATS(formats)
+#define ZX_STATS_LAYER(layer)
+#define ZX_STATS_TIMER(stage)
+#define ZX_STATS_COUNT(counter, n) ((void)0)
+
+#endif
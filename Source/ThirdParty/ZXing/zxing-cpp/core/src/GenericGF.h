@@ -10,7 +10,6 @@
 #include "ZXConfig.h"
 
 #include <stdexcept>
-#include <vector>
 
 namespace ZXing {
 
@@ -29,21 +28,23 @@ class GenericGF
 {
 	const int _size;
 	int _generatorBase;
-	std::vector<short> _expTable;
-	std::vector<short> _logTable;
+	const short* _expTable;
+	const short* _logTable;
 
 	/**
-	* Create a representation of GF(size) using the given primitive polynomial.
+	* Create a representation of GF(size) from its exp and log tables. Those are generated at compile time
+	* (see GFTables in GenericGF.cpp), so all fields are constant initialized.
 	*
-	* @param primitive irreducible polynomial whose coefficients are represented by
-	*  the bits of an int, where the least-significant bit represents the constant
-	*  coefficient
-	* @param size the size of the field (m = log2(size) is called the word size of the encoding)
+	* @param tables exp and log tables, the size of the log table is the size of the field
+	*  (m = log2(size) is called the word size of the encoding)
 	* @param b the factor b in the generator polynomial can be 0- or 1-based
 	*  (g(x) = (x+a^b)(x+a^(b+1))...(x+a^(b+2t-1))).
 	*  In most cases it should be 1, but for QR code it is 0.
 	*/
-	GenericGF(int primitive, int size, int b);
+	template <typename Tables>
+	constexpr GenericGF(const Tables& tables, int b)
+		: _size(static_cast<int>(tables.log.size())), _generatorBase(b), _expTable(tables.exp.data()), _logTable(tables.log.data())
+	{}
 
 public:
 	static const GenericGF& AztecData12();
@@ -63,7 +64,7 @@ public:
 	* @return 2 to the power of a in GF(size)
 	*/
 	int exp(int a) const {
-		return _expTable.at(a);
+		return _expTable[a];
 	}
 
 	/**
@@ -73,7 +74,7 @@ public:
 		if (a == 0) {
 			throw std::invalid_argument("a == 0");
 		}
-		return _logTable.at(a);
+		return _logTable[a];
 	}
 
 	/**
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <functional>
 #include <utility>
 
@@ -138,6 +139,48 @@ bool GlobalHistogramBinarizer::getPatternRow(int row, int rotation, PatternRow&
 	return true;
 }
 
+/**
+ * Moves the edges between the bars and spaces in bars (the integer pattern row of line) to the peak of the luminance
+ * gradient, which is estimated with a parabolic fit around the pixel boundary of each edge. The resulting widths are in
+ * units of 1/scale pixels. An edge is moved by less than half a pixel, so all widths stay positive.
+ */
+static void RefineEdges(const ImageLineView line, int scale, PatternRow& bars)
+{
+	const int width = Size(line);
+	const int maxShift = scale / 2 - 1;
+	// the luminance gradient at the boundary in front of pixel i, multiplied by the sign of the edge, clipped at 0
+	auto gradient = [&](int i, int sign) { return i > 0 && i < width ? std::max(0, sign * (line[i] - line[i - 1])) : 0; };
+
+	int pos = 0;    // pixel boundary of the current edge
+	int scaled = 0; // refined and scaled position of the previous edge
+	for (int k = 0; k < Size(bars) - 1; ++k) {
+		pos += bars[k];
+		int edge = pos * scale;
+		if (pos > 0 && pos < width) {
+			// a space (even k) followed by a bar is a falling edge
+			const int sign = k % 2 ? 1 : -1;
+			int l = gradient(pos - 1, sign), c = gradient(pos, sign), r = gradient(pos + 1, sign);
+			int denom = l - 2 * c + r;
+			if (denom < 0) {
+				int shift = narrow_cast<int>(std::lround(scale * (l - r) / (2.f * denom)));
+				edge += std::clamp(shift, -maxShift, maxShift);
+			}
+		}
+		bars[k] = narrow_cast<PatternType>(edge - scaled);
+		scaled = edge;
+	}
+	bars.back() = narrow_cast<PatternType>(width * scale - scaled);
+}
+
+bool GlobalHistogramBinarizer::getSubPixelPatternRow(int row, int rotation, int scale, PatternRow& res) const
+{
+	if (!getPatternRow(row, rotation, res))
+		return false;
+	if (scale > 1)
+		RefineEdges(RowView(_buffer.rotated(rotation), row), scale, res);
+	return true;
+}
+
 // Does not sharpen the data, as this call is intended to only be used by 2D Readers.
 std::shared_ptr<const BitMatrix>
 GlobalHistogramBinarizer::getBlackMatrix() const
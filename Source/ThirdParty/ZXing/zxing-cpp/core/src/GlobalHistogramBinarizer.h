@@ -28,6 +28,7 @@ public:
 	~GlobalHistogramBinarizer() override;
 
 	bool getPatternRow(int row, int rotation, PatternRow &res) const override;
+	bool getSubPixelPatternRow(int row, int rotation, int scale, PatternRow& res) const override;
 	std::shared_ptr<const BitMatrix> getBlackMatrix() const override;
 };
 
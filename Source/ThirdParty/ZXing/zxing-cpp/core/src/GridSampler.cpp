@@ -7,6 +7,10 @@
 
 #include "GridSampler.h"
 
+#include "DecodeStatsSink.h"
+
+#include <vector>
+
 #ifdef PRINT_DEBUG
 #include "LogMatrix.h"
 #include "BitMatrixIO.h"
@@ -36,29 +40,42 @@ DetectorResult SampleGrid(const BitMatrix& image, int width, int height, const R
 	for (auto&& [x0, x1, y0, y1, mod2Pix] : rois) {
 		// Precheck the corners of every roi to bail out early if the grid is "obviously" not completely inside the image
 		auto isInside = [&mod2Pix = mod2Pix, &image](int x, int y) { return image.isIn(mod2Pix(centered(PointI(x, y)))); };
-		if (!mod2Pix.isValid() || !isInside(x0, y0) || !isInside(x1 - 1, y0) || !isInside(x1 - 1, y1 - 1) || !isInside(x0, y1 - 1))
+		if (!mod2Pix.isValid() || !isInside(x0, y0) || !isInside(x1 - 1, y0) || !isInside(x1 - 1, y1 - 1) || !isInside(x0, y1 - 1)) {
+			ZX_STATS_COUNT(GridSampleRejections, 1);
 			return {};
+		}
 	}
 
 	BitMatrix res(width, height);
+	std::vector<PointF::value_t> xs(width), ys(width);
+	const PointF::value_t imgWidth = image.width(), imgHeight = image.height();
 	for (auto&& [x0, x1, y0, y1, mod2Pix] : rois) {
-		for (int y = y0; y < y1; ++y)
-			for (int x = x0; x < x1; ++x) {
-				auto p = mod2Pix(centered(PointI{x, y}));
-				// Due to a "numerical instability" in the PerspectiveTransform generation/application it has been observed
-				// that even though all boundary grid points get projected inside the image, it can still happen that an
-				// inner grid points is not. See #563. A true perspective transformation cannot have this property.
-				// The following check takes 100% care of the issue and turned out to be less of a performance impact than feared.
-				// TODO: Check some mathematical/numercial property of mod2Pix to determine if it is a perspective transforation.
-				if (!image.isIn(p))
-					return {};
+		for (int y = y0; y < y1; ++y) {
+			const int n = x1 - x0;
+			mod2Pix.projectRow(x0, x1, y, xs.data(), ys.data());
+
+			// Due to a "numerical instability" in the PerspectiveTransform generation/application it has been observed
+			// that even though all boundary grid points get projected inside the image, it can still happen that an
+			// inner grid points is not. See #563. A true perspective transformation cannot have this property.
+			// The following check takes 100% care of the issue. It is done once per row without branches (same as
+			// BitMatrix::isIn for every point) so it does not prevent the vectorization.
+			// TODO: Check some mathematical/numercial property of mod2Pix to determine if it is a perspective transforation.
+			bool inside = true;
+			for (int i = 0; i < n; ++i)
+				inside &= (0 <= xs[i]) & (xs[i] < imgWidth) & (0 <= ys[i]) & (ys[i] < imgHeight);
+			if (!inside) {
+				ZX_STATS_COUNT(GridSampleRejections, 1);
+				return {};
+			}
 
+			for (int i = 0; i < n; ++i) {
 #ifdef PRINT_DEBUG
-				log(p, 3);
+				log(PointF(xs[i], ys[i]), 3);
 #endif
-				if (image.get(p))
-					res.set(x, y);
+				if (image.get(static_cast<int>(xs[i]), static_cast<int>(ys[i])))
+					res.set(x0 + i, y);
 			}
+		}
 	}
 
 #ifdef PRINT_DEBUG
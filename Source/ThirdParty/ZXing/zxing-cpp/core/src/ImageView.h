@@ -6,7 +6,11 @@
 #pragma once
 
 #include <algorithm>
+#include <climits>
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
 
 namespace ZXing {
 
@@ -71,7 +75,8 @@ public:
 	int rowStride() const { return _rowStride; }
 	ImageFormat format() const { return _format; }
 
-	const uint8_t* data(int x, int y) const { return _data + y * _rowStride + x * _pixStride; }
+	// the offset is calculated in ptrdiff_t, it exceeds INT_MAX in very large images (e.g. 80000 rows of 30000 bytes)
+	const uint8_t* data(int x, int y) const { return _data + ptrdiff_t(y) * _rowStride + ptrdiff_t(x) * _pixStride; }
 
 	ImageView cropped(int left, int top, int width, int height) const
 	{
@@ -94,6 +99,8 @@ public:
 
 	ImageView subsampled(int scale) const
 	{
+		if (std::abs(int64_t(_rowStride) * scale) > INT_MAX)
+			throw std::invalid_argument("ImageView row stride overflow");
 		return {_data, _width / scale, _height / scale, _format, _rowStride * scale, _pixStride * scale};
 	}
 
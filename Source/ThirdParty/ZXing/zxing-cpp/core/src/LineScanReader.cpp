@@ -0,0 +1,130 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LineScanReader.h"
+
+#include "GlobalHistogramBinarizer.h"
+#include "ThresholdBinarizer.h"
+#include "oned/ODReader.h"
+
+#include <utility>
+#include <vector>
+
+namespace ZXing {
+
+struct LineScanReader::State
+{
+	struct Seen
+	{
+		int lastRow = 0;
+		bool reported = false;
+	};
+
+	DecodeHints hints; // the RowReaders keep a reference to this copy
+	OneD::RowReaders readers;
+	OneD::DecodingStates decodingStates;
+	Results symbols; // all symbols that might still be continued by the next row
+	std::vector<Seen> seen; // parallel to symbols
+	PatternRow bars;
+	std::vector<uint8_t> lum;
+	int row = 0;
+	int lastStateReset = 0;
+
+	explicit State(const DecodeHints& h)
+		: hints(h), readers(OneD::CreateRowReaders(hints)), decodingStates(readers.size())
+	{
+		bars.reserve(128);
+	}
+};
+
+LineScanReader::LineScanReader(const DecodeHints& hints) : _state(std::make_unique<State>(hints)) {}
+
+LineScanReader::~LineScanReader() = default;
+
+LineScanReader::LineScanReader(LineScanReader&&) noexcept = default;
+LineScanReader& LineScanReader::operator=(LineScanReader&&) noexcept = default;
+
+int LineScanReader::rowCount() const
+{
+	return _state->row;
+}
+
+void LineScanReader::reset()
+{
+	auto& s = *_state;
+	for (auto& state : s.decodingStates)
+		state.reset();
+	s.symbols.clear();
+	s.seen.clear();
+	s.row = 0;
+	s.lastStateReset = 0;
+}
+
+Results LineScanReader::addRow(const ImageView& iv)
+{
+	auto& s = *_state;
+	const auto& hints = s.hints;
+
+	ImageView row = iv.cropped(0, 0, iv.width(), 1);
+	const bool useHistogram = hints.binarizer() == Binarizer::GlobalHistogram || hints.binarizer() == Binarizer::LocalAverage;
+	if (useHistogram && (row.format() != ImageFormat::Lum || row.pixStride() != 1)) {
+		// GlobalHistogram needs dense lum data (see SetupLumImageView)
+		s.lum.resize(row.width());
+		const int r = RedIndex(row.format()), g = GreenIndex(row.format()), b = BlueIndex(row.format());
+		for (int x = 0; x < row.width(); ++x) {
+			auto src = row.data(x, 0);
+			s.lum[x] = row.format() == ImageFormat::Lum ? *src : RGBToLum(src[r], src[g], src[b]);
+		}
+		row = ImageView(s.lum.data(), row.width(), 1, ImageFormat::Lum);
+	}
+
+	bool hasBars = false;
+	switch (hints.binarizer()) {
+	case Binarizer::BoolCast: hasBars = ThresholdBinarizer(row, 0).getPatternRow(0, 0, s.bars); break;
+	case Binarizer::FixedThreshold: hasBars = ThresholdBinarizer(row, 127).getPatternRow(0, 0, s.bars); break;
+	default: hasBars = GlobalHistogramBinarizer(row).getPatternRow(0, 0, s.bars); break;
+	}
+
+	Results res;
+	if (hasBars) {
+		OneD::DecodeRow(s.readers, s.decodingStates, s.row, s.bars, row.width(), false, hints.tryHarder(), false,
+						hints.returnErrors(), s.symbols, [&](int index, bool isNew) {
+							if (isNew)
+								s.seen.emplace_back();
+							auto& seen = s.seen[index];
+							seen.lastRow = s.row;
+							if (!seen.reported && s.symbols[index].lineCount() >= hints.minLineCount()) {
+								seen.reported = true;
+								res.push_back(s.symbols[index]);
+								res.back().setDecodeHints(hints);
+							}
+							return false;
+						});
+	}
+
+	// Forget all symbols that can not be continued by any of the following rows. A line belongs to a known symbol
+	// only if it is less than half the length of the symbol away from it (see Result::operator==).
+	for (int i = Size(s.symbols) - 1; i >= 0; --i) {
+		const auto& pos = s.symbols[i].position();
+		if (s.row - s.seen[i].lastRow > maxAbsComponent(pos.topLeft() - pos.bottomRight()) / 2 + 1) {
+			s.symbols.erase(s.symbols.begin() + i);
+			s.seen.erase(s.seen.begin() + i);
+		}
+	}
+
+	// The stacked DataBar readers collect partial symbols in their decoding state. Discard those from time to time
+	// when no symbol is in sight, so the memory consumption does not grow with the length of the stream.
+	if (s.symbols.empty() && s.row - s.lastStateReset > row.width()) {
+		for (auto& state : s.decodingStates)
+			state.reset();
+		s.lastStateReset = s.row;
+	}
+
+	++s.row;
+
+	return res;
+}
+
+} // ZXing
@@ -0,0 +1,55 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "DecodeHints.h"
+#include "ImageView.h"
+#include "Result.h"
+
+#include <memory>
+
+namespace ZXing {
+
+/**
+ * @brief The LineScanReader class decodes linear barcodes from a stream of single image rows.
+ *
+ * This is meant for line-scan cameras (e.g. above a conveyor belt) that deliver one row at a time. Each row is
+ * binarized and passed through the same linear readers that ReadBarcodes uses. Only the state needed to match lines
+ * of symbols that span several rows is kept (including the stacked DataBar decoding state). So memory usage is
+ * independent of the number of rows and a symbol is reported with the row that makes it reach
+ * DecodeHints::minLineCount. Every symbol is reported exactly once, as long as it stays visible.
+ *
+ * The row numbers (y coordinates of the result positions) count the rows since construction or the last reset().
+ * Only the linear formats of DecodeHints::formats() are considered, tryRotate, tryDownscale and isPure are ignored.
+ */
+class LineScanReader
+{
+	struct State;
+	std::unique_ptr<State> _state;
+
+public:
+	explicit LineScanReader(const DecodeHints& hints = {});
+	~LineScanReader();
+
+	LineScanReader(LineScanReader&&) noexcept;
+	LineScanReader& operator=(LineScanReader&&) noexcept;
+
+	/**
+	 * Process the next row of the stream
+	 *
+	 * @param row  view of the image row, only the first row of the view is processed
+	 * @return #Results list of symbols that reached the minLineCount with this row, usually empty
+	 */
+	Results addRow(const ImageView& row);
+
+	/// Number of rows processed since construction or the last reset()
+	int rowCount() const;
+
+	/// Forget all partially seen symbols and restart the row counting at 0
+	void reset();
+};
+
+} // ZXing
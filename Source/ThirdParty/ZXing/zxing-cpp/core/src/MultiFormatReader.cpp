@@ -9,6 +9,7 @@
 #include "BarcodeFormat.h"
 #include "BinaryBitmap.h"
 #include "DecodeHints.h"
+#include "DecodeStatsSink.h"
 #include "aztec/AZReader.h"
 #include "datamatrix/DMReader.h"
 #include "maxicode/MCReader.h"
@@ -24,24 +25,30 @@ MultiFormatReader::MultiFormatReader(const DecodeHints& hints) : _hints(hints)
 {
 	auto formats = hints.formats().empty() ? BarcodeFormat::Any : hints.formats();
 
+	// remember the formats of each reader for the DecodeStats attribution
+	auto add = [&](Reader* reader, BarcodeFormats readerFormats) {
+		_readers.emplace_back(reader);
+		_formats.push_back(formats & readerFormats);
+	};
+
 	// Put linear readers upfront in "normal" mode
 	if (formats.testFlags(BarcodeFormat::LinearCodes) && !hints.tryHarder())
-		_readers.emplace_back(new OneD::Reader(hints));
+		add(new OneD::Reader(hints), BarcodeFormat::LinearCodes);
 
 	if (formats.testFlags(BarcodeFormat::QRCode | BarcodeFormat::MicroQRCode))
-		_readers.emplace_back(new QRCode::Reader(hints, true));
+		add(new QRCode::Reader(hints, true), BarcodeFormat::QRCode | BarcodeFormat::MicroQRCode);
 	if (formats.testFlag(BarcodeFormat::DataMatrix))
-		_readers.emplace_back(new DataMatrix::Reader(hints, true));
+		add(new DataMatrix::Reader(hints, true), BarcodeFormat::DataMatrix);
 	if (formats.testFlag(BarcodeFormat::Aztec))
-		_readers.emplace_back(new Aztec::Reader(hints, true));
+		add(new Aztec::Reader(hints, true), BarcodeFormat::Aztec);
 	if (formats.testFlag(BarcodeFormat::PDF417))
-		_readers.emplace_back(new Pdf417::Reader(hints));
+		add(new Pdf417::Reader(hints), BarcodeFormat::PDF417);
 	if (formats.testFlag(BarcodeFormat::MaxiCode))
-		_readers.emplace_back(new MaxiCode::Reader(hints));
+		add(new MaxiCode::Reader(hints), BarcodeFormat::MaxiCode);
 
 	// At end in "try harder" mode
 	if (formats.testFlags(BarcodeFormat::LinearCodes) && hints.tryHarder())
-		_readers.emplace_back(new OneD::Reader(hints));
+		add(new OneD::Reader(hints), BarcodeFormat::LinearCodes);
 }
 
 MultiFormatReader::~MultiFormatReader() = default;
@@ -50,8 +57,10 @@ Result
 MultiFormatReader::read(const BinaryBitmap& image) const
 {
 	Result r;
-	for (const auto& reader : _readers) {
-		r = reader->decode(image);
+	for (int i = 0; i < Size(_readers); ++i) {
+		ZX_STATS_FORMATS(_formats[i]);
+		ZX_STATS_TIMER(Detection);
+		r = _readers[i]->decode(image);
   		if (r.isValid())
 			return r;
 	}
@@ -62,10 +71,15 @@ Results MultiFormatReader::readMultiple(const BinaryBitmap& image, int maxSymbol
 {
 	std::vector<Result> res;
 
-	for (const auto& reader : _readers) {
-		if (image.inverted() && !reader->supportsInversion)
+	for (int i = 0; i < Size(_readers); ++i) {
+		if (image.inverted() && !_readers[i]->supportsInversion)
 			continue;
-		auto r = reader->decode(image, maxSymbols);
+		Results r;
+		{
+			ZX_STATS_FORMATS(_formats[i]);
+			ZX_STATS_TIMER(Detection);
+			r = _readers[i]->decode(image, maxSymbols);
+		}
 		if (!_hints.returnErrors()) {
 			//TODO: C++20 res.erase_if()
 			auto it = std::remove_if(res.begin(), res.end(), [](auto&& r) { return !r.isValid(); });
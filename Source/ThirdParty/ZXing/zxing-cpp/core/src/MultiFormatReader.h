@@ -40,6 +40,7 @@ public:
 
 private:
 	std::vector<std::unique_ptr<Reader>> _readers;
+	std::vector<BarcodeFormats> _formats; // formats handled by each reader
 	const DecodeHints& _hints;
 };
 
@@ -0,0 +1,80 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ZXing {
+
+/**
+ * @brief NumWorkerThreads returns the number of threads to use for a parallel job of size count.
+ *
+ * @param numThreads  requested number of threads, 0 means std::thread::hardware_concurrency()
+ * @param count  number of independent work items, there is no point in starting more threads than that
+ */
+inline int NumWorkerThreads(int numThreads, int count)
+{
+	if (numThreads <= 0)
+		numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	return std::max(1, std::min(numThreads, count));
+}
+
+/**
+ * @brief ParallelFor calls func(index, worker) for every index in [0, count) using up to numThreads threads.
+ *
+ * The work items are handed out dynamically from a shared counter, so a worker that finishes early simply picks up
+ * the next item. This balances items of very different cost without any static partitioning. The worker parameter
+ * is in [0, NumWorkerThreads(numThreads, count)) and can be used to index per-thread scratch data. The calling
+ * thread participates as worker 0. If func throws, the remaining items are skipped and the first exception is
+ * rethrown after all threads have been joined.
+ */
+template <typename F>
+void ParallelFor(int count, int numThreads, F&& func)
+{
+	if (count <= 0)
+		return;
+
+	const int numWorkers = NumWorkerThreads(numThreads, count);
+	if (numWorkers == 1) {
+		for (int i = 0; i < count; ++i)
+			func(i, 0);
+		return;
+	}
+
+	std::atomic<int> next{0};
+	std::exception_ptr error;
+	std::mutex errorMutex;
+
+	auto work = [&](int worker) {
+		try {
+			for (int i = next++; i < count; i = next++)
+				func(i, worker);
+		} catch (...) {
+			std::lock_guard lock(errorMutex);
+			if (!error)
+				error = std::current_exception();
+			next = count;
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(numWorkers - 1);
+	for (int worker = 1; worker < numWorkers; ++worker)
+		threads.emplace_back(work, worker);
+	work(0);
+	for (auto& thread : threads)
+		thread.join();
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+} // ZXing
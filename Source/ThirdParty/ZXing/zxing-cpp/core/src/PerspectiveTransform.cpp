@@ -78,4 +78,17 @@ PointF PerspectiveTransform::operator()(PointF p) const
 	return {(a11 * p.x + a21 * p.y + a31) / denominator, (a12 * p.x + a22 * p.y + a32) / denominator};
 }
 
+void PerspectiveTransform::projectRow(int x0, int x1, int y, value_t* xs, value_t* ys) const
+{
+	// keep the exact order of operations of operator() so the results are bit identical, the row invariant
+	// products get hoisted out of the loop by the compiler
+	const value_t py = y + 0.5;
+	for (int i = 0, n = x1 - x0; i < n; ++i) {
+		const value_t px = x0 + i + 0.5;
+		auto denominator = a13 * px + a23 * py + a33;
+		xs[i] = (a11 * px + a21 * py + a31) / denominator;
+		ys[i] = (a12 * px + a22 * py + a32) / denominator;
+	}
+}
+
 } // ZXing
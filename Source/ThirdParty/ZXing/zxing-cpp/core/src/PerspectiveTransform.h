@@ -39,6 +39,10 @@ public:
 	/// Project from the destination space (grid of modules) into the image space (bit matrix)
 	PointF operator()(PointF p) const;
 
+	/// Project the module centers (x + 0.5, y + 0.5) for all x in [x0, x1) into the image space. The results are
+	/// identical to the ones of operator() but the loop can be vectorized by the compiler.
+	void projectRow(int x0, int x1, int y, value_t* xs, value_t* ys) const;
+
 	bool isValid() const { return !std::isnan(a33); }
 };
 
@@ -50,7 +50,9 @@ struct Range
 	Iterator begin() const noexcept { return _begin; }
 	Iterator end() const noexcept { return _end; }
 	explicit operator bool() const { return begin() < end(); }
+	bool empty() const { return !(begin() < end()); }
 	int size() const { return narrow_cast<int>(end() - begin()); }
+	decltype(auto) operator[](int i) const { return begin()[i]; }
 };
 
 template <typename C>
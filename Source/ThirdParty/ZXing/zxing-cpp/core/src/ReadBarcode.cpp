@@ -6,14 +6,19 @@
 #include "ReadBarcode.h"
 
 #include "DecodeHints.h"
+#include "DecodeStatsSink.h"
 #include "GlobalHistogramBinarizer.h"
 #include "HybridBinarizer.h"
 #include "MultiFormatReader.h"
+#include "Parallel.h"
 #include "Pattern.h"
 #include "ThresholdBinarizer.h"
 
+#include <chrono>
 #include <climits>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <stdexcept>
 
 namespace ZXing {
@@ -21,41 +26,49 @@ namespace ZXing {
 class LumImage : public ImageView
 {
 	std::unique_ptr<uint8_t[]> _memory;
-	LumImage(std::unique_ptr<uint8_t[]>&& data, int w, int h)
-		: ImageView(data.get(), w, h, ImageFormat::Lum), _memory(std::move(data))
-	{}
+	int _capacity = 0;
 
 public:
 	LumImage() : ImageView(nullptr, 0, 0, ImageFormat::Lum) {}
-	LumImage(int w, int h) : LumImage(std::make_unique<uint8_t[]>(w * h), w, h) {}
+	LumImage(int w, int h) : LumImage() { reshape(w, h); }
+
+	// (re)use the buffer for an image of size w x h, memory is only allocated if the current buffer is too small
+	void reshape(int w, int h)
+	{
+		if (w * h > _capacity) {
+			_memory = std::make_unique<uint8_t[]>(w * h);
+			_capacity = w * h;
+		}
+		static_cast<ImageView&>(*this) = ImageView(_memory.get(), w, h, ImageFormat::Lum);
+	}
 
 	uint8_t* data() { return _memory.get(); }
 };
 
 template<typename P>
-static LumImage ExtractLum(const ImageView& iv, P projection)
+static void ExtractLum(const ImageView& iv, LumImage& res, P projection)
 {
-	LumImage res(iv.width(), iv.height());
+	res.reshape(iv.width(), iv.height());
 
 	auto* dst = res.data();
 	for(int y = 0; y < iv.height(); ++y)
 		for(int x = 0, w = iv.width(); x < w; ++x)
 			*dst++ = projection(iv.data(x, y));
-
-	return res;
 }
 
 class LumImagePyramid
 {
-	std::vector<LumImage> buffers;
+	std::vector<LumImage>& buffers;
 
 	template<int N>
 	void addLayer()
 	{
 		auto siv = layers.back();
-		buffers.emplace_back(siv.width() / N, siv.height() / N);
-		layers.push_back(buffers.back());
-		auto& div = buffers.back();
+		if (Size(buffers) < Size(layers))
+			buffers.emplace_back();
+		auto& div = buffers[layers.size() - 1];
+		div.reshape(siv.width() / N, siv.height() / N);
+		layers.push_back(div);
 		auto* d   = div.data();
 
 		for (int dy = 0; dy < div.height(); ++dy)
@@ -82,7 +95,8 @@ class LumImagePyramid
 public:
 	std::vector<ImageView> layers;
 
-	LumImagePyramid(const ImageView& iv, int threshold, int factor)
+	// the layer images are stored in (and reuse the memory of) buffers
+	LumImagePyramid(const ImageView& iv, int threshold, int factor, std::vector<LumImage>& buffers) : buffers(buffers)
 	{
 		layers.push_back(iv);
 		// TODO: if only matrix codes were considered, then using std::min would be sufficient (see #425)
@@ -105,14 +119,14 @@ ImageView SetupLumImageView(ImageView iv, LumImage& lum, const DecodeHints& hint
 
 	if (hints.binarizer() == Binarizer::GlobalHistogram || hints.binarizer() == Binarizer::LocalAverage) {
 		if (iv.format() != ImageFormat::Lum) {
-			lum = ExtractLum(iv, [r = RedIndex(iv.format()), g = GreenIndex(iv.format()), b = BlueIndex(iv.format())](
-									 const uint8_t* src) { return RGBToLum(src[r], src[g], src[b]); });
+			ExtractLum(iv, lum, [r = RedIndex(iv.format()), g = GreenIndex(iv.format()), b = BlueIndex(iv.format())](
+									const uint8_t* src) { return RGBToLum(src[r], src[g], src[b]); });
+			return lum;
 		} else if (iv.pixStride() != 1) {
 			// GlobalHistogram and LocalAverage need dense line memory layout
-			lum = ExtractLum(iv, [](const uint8_t* src) { return *src; });
-		}
-		if (lum.data())
+			ExtractLum(iv, lum, [](const uint8_t* src) { return *src; });
 			return lum;
+		}
 	}
 	return iv;
 }
@@ -128,39 +142,68 @@ std::unique_ptr<BinaryBitmap> CreateBitmap(ZXing::Binarizer binarizer, const Ima
 	return {}; // silence gcc warning
 }
 
-Result ReadBarcode(const ImageView& _iv, const DecodeHints& hints)
+/**
+ * The ReaderContext holds everything that can be reused between ReadBarcodes calls with the same hints: the
+ * MultiFormatReader(s) and the scratch memory for the luminance image and the downscaled pyramid layers. It is not
+ * thread safe, concurrent decoders need one context each.
+ */
+class ReaderContext
 {
-	return FirstOrDefault(ReadBarcodes(_iv, DecodeHints(hints).setMaxNumberOfSymbols(1)));
-}
+	DecodeHints _hints; // the readers keep a reference to this copy
+	MultiFormatReader _reader;
+	std::unique_ptr<DecodeHints> _closedHints;
+	std::unique_ptr<MultiFormatReader> _closedReader;
+	LumImage _lum;
+	std::vector<LumImage> _layers;
 
-Results ReadBarcodes(const ImageView& _iv, const DecodeHints& hints)
+public:
+	explicit ReaderContext(const DecodeHints& hints) : _hints(hints), _reader(_hints)
+	{
+#ifdef BUILD_EXPERIMENTAL_API
+		auto formatsBenefittingFromClosing = BarcodeFormat::Aztec | BarcodeFormat::DataMatrix | BarcodeFormat::QRCode | BarcodeFormat::MicroQRCode;
+		if (!hints.isPure() && hints.tryDenoise() && hints.hasFormat(formatsBenefittingFromClosing)) {
+			_closedHints = std::make_unique<DecodeHints>(hints);
+			_closedHints->setFormats((hints.formats().empty() ? BarcodeFormat::Any : hints.formats()) & formatsBenefittingFromClosing);
+			_closedReader = std::make_unique<MultiFormatReader>(*_closedHints);
+		}
+#endif
+	}
+
+	ReaderContext(const ReaderContext&) = delete;
+	ReaderContext& operator=(const ReaderContext&) = delete;
+
+	// stats (if not nullptr) receives the DecodeStats of this call
+	Results read(const ImageView& _iv, DecodeStats* stats = nullptr);
+};
+
+Results ReaderContext::read(const ImageView& _iv, [[maybe_unused]] DecodeStats* stats)
 {
+	ZX_STATS_SINK(stats);
+	const auto& hints = _hints;
+
 	if (sizeof(PatternType) < 4 && hints.hasFormat(BarcodeFormat::LinearCodes) && (_iv.width() > 0xffff || _iv.height() > 0xffff))
 		throw std::invalid_argument("maximum image width/height is 65535");
 
-	LumImage lum;
-	ImageView iv = SetupLumImageView(_iv, lum, hints);
-	MultiFormatReader reader(hints);
+	ImageView iv = [&] {
+		ZX_STATS_TIMER(LumExtraction);
+		return SetupLumImageView(_iv, _lum, hints);
+	}();
 
 	if (hints.isPure())
-		return {reader.read(*CreateBitmap(hints.binarizer(), iv))};
+		return {_reader.read(*CreateBitmap(hints.binarizer(), iv))};
 
-	std::unique_ptr<MultiFormatReader> closedReader;
-#ifdef BUILD_EXPERIMENTAL_API
-	auto formatsBenefittingFromClosing = BarcodeFormat::Aztec | BarcodeFormat::DataMatrix | BarcodeFormat::QRCode | BarcodeFormat::MicroQRCode;
-	if (hints.tryDenoise() && hints.hasFormat(formatsBenefittingFromClosing)) {
-		DecodeHints closedHints = hints;
-		closedHints.setFormats((hints.formats().empty() ? BarcodeFormat::Any : hints.formats()) & formatsBenefittingFromClosing);
-		closedReader = std::make_unique<MultiFormatReader>(closedHints);
-	}
-#endif
-	LumImagePyramid pyramid(iv, hints.downscaleThreshold() * hints.tryDownscale(), hints.downscaleFactor());
+	auto pyramid = [&] {
+		ZX_STATS_TIMER(Pyramid);
+		return LumImagePyramid(iv, hints.downscaleThreshold() * hints.tryDownscale(), hints.downscaleFactor(), _layers);
+	}();
 
 	Results results;
 	int maxSymbols = hints.maxNumberOfSymbols() ? hints.maxNumberOfSymbols() : INT_MAX;
-	for (auto&& iv : pyramid.layers) {
+	for (int layer = 0; layer < Size(pyramid.layers); ++layer) {
+		ZX_STATS_LAYER(layer);
+		const auto& iv = pyramid.layers[layer];
 		auto bitmap = CreateBitmap(hints.binarizer(), iv);
-		for (int close = 0; close <= (closedReader ? 1 : 0); ++close) {
+		for (int close = 0; close <= (_closedReader ? 1 : 0); ++close) {
 			if (close)
 				bitmap->close();
 
@@ -168,7 +211,7 @@ Results ReadBarcodes(const ImageView& _iv, const DecodeHints& hints)
 			for (int invert = 0; invert <= static_cast<int>(hints.tryInvert() && !close); ++invert) {
 				if (invert)
 					bitmap->invert();
-				auto rs = (close ? *closedReader : reader).readMultiple(*bitmap, maxSymbols);
+				auto rs = (close ? *_closedReader : _reader).readMultiple(*bitmap, maxSymbols);
 				for (auto& r : rs) {
 					if (iv.width() != _iv.width())
 						r.setPosition(Scale(r.position(), _iv.width() / iv.width()));
@@ -188,4 +231,109 @@ Results ReadBarcodes(const ImageView& _iv, const DecodeHints& hints)
 	return results;
 }
 
+Result ReadBarcode(const ImageView& _iv, const DecodeHints& hints)
+{
+	return FirstOrDefault(ReadBarcodes(_iv, DecodeHints(hints).setMaxNumberOfSymbols(1)));
+}
+
+Results ReadBarcodes(const ImageView& _iv, const DecodeHints& hints)
+{
+	return ReaderContext(hints).read(_iv);
+}
+
+Results ReadBarcodes(const ImageView& _iv, const DecodeHints& hints, DecodeStats& stats)
+{
+	return ReaderContext(hints).read(_iv, &stats);
+}
+
+Results ReadBarcodesTiled(const ImageView& iv, const DecodeHints& hints, int tileSize, int overlap, int numThreads)
+{
+	if (tileSize <= 0 || overlap < 0 || overlap >= tileSize)
+		throw std::invalid_argument("Invalid tile size / overlap");
+	if (sizeof(PatternType) < 4 && hints.hasFormat(BarcodeFormat::LinearCodes) && tileSize > 0xffff)
+		throw std::invalid_argument("maximum tile size is 65535");
+
+	// the first and last tile in each row/column are aligned to the image border, the inner ones are distributed
+	// with a constant step of tileSize - overlap
+	auto tileOrigins = [tileSize, step = tileSize - overlap](int size) {
+		std::vector<int> res = {0};
+		while (res.back() + tileSize < size)
+			res.push_back(std::min(res.back() + step, size - tileSize));
+		return res;
+	};
+	const auto xs = tileOrigins(iv.width());
+	const auto ys = tileOrigins(iv.height());
+	const int numTiles = Size(xs) * Size(ys);
+
+	std::vector<Results> tileResults(numTiles);
+	std::vector<std::optional<ReaderContext>> contexts(NumWorkerThreads(numThreads, numTiles));
+	ParallelFor(numTiles, numThreads, [&](int i, int worker) {
+		if (!contexts[worker])
+			contexts[worker].emplace(hints);
+		PointI origin = {xs[i % Size(xs)], ys[i / Size(xs)]};
+		auto rs = contexts[worker]->read(iv.cropped(origin.x, origin.y, tileSize, tileSize));
+		for (auto& r : rs) {
+			auto position = r.position();
+			for (auto& p : position)
+				p += origin;
+			r.setPosition(position);
+		}
+		tileResults[i] = std::move(rs);
+	});
+
+	// merge in tile order to get a deterministic result, independent of the thread scheduling
+	Results results;
+	for (auto& rs : tileResults)
+		for (auto& r : rs)
+			if (!Contains(results, r))
+				results.push_back(std::move(r));
+
+	// sort results based on their position on the image (see MultiFormatReader::readMultiple)
+	std::stable_sort(results.begin(), results.end(), [](const Result& l, const Result& r) {
+		auto lp = l.position().topLeft();
+		auto rp = r.position().topLeft();
+		return lp.y < rp.y || (lp.y == rp.y && lp.x < rp.x);
+	});
+
+	if (hints.maxNumberOfSymbols() && Size(results) > hints.maxNumberOfSymbols())
+		results.resize(hints.maxNumberOfSymbols());
+
+	return results;
+}
+
+std::vector<Results> ReadBarcodesBatch(const std::vector<ImageView>& images, const DecodeHints& hints, int numThreads,
+									   BatchStats* stats)
+{
+	auto startTime = std::chrono::steady_clock::now();
+	const int count = Size(images);
+
+	// Hand out the largest images first. Together with the dynamic scheduling of ParallelFor this keeps a single
+	// huge image at the end of the list from serializing the whole batch.
+	std::vector<int> order(count);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&images](int l, int r) {
+		return int64_t(images[l].width()) * images[l].height() > int64_t(images[r].width()) * images[r].height();
+	});
+
+	std::vector<Results> results(count);
+	std::vector<std::optional<ReaderContext>> contexts(NumWorkerThreads(numThreads, count));
+	std::vector<DecodeStats> decodeStats(stats ? contexts.size() : 0);
+	ParallelFor(count, numThreads, [&](int i, int worker) {
+		if (!contexts[worker])
+			contexts[worker].emplace(hints);
+		results[order[i]] = contexts[worker]->read(images[order[i]], stats ? &decodeStats[worker] : nullptr);
+	});
+
+	if (stats) {
+		for (auto& ds : decodeStats)
+			stats->decode += ds;
+		stats->images += count;
+		for (auto& rs : results)
+			stats->symbols += Size(rs);
+		stats->seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	return results;
+}
+
 } // ZXing
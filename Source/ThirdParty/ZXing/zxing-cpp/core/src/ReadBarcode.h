@@ -6,9 +6,13 @@
 #pragma once
 
 #include "DecodeHints.h"
+#include "DecodeStats.h"
 #include "ImageView.h"
 #include "Result.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace ZXing {
 
 /**
@@ -29,5 +33,64 @@ Result ReadBarcode(const ImageView& buffer, const DecodeHints& hints = {});
  */
 Results ReadBarcodes(const ImageView& buffer, const DecodeHints& hints = {});
 
+/**
+ * Read barcodes from an ImageView and record where the time went
+ *
+ * @param buffer  view of the image data including layout and format
+ * @param hints  DecodeHints to parameterize / speed up decoding
+ * @param stats  receives the per-stage timings and counters (accumulated, only if built with BUILD_DECODE_STATS)
+ * @return #Results list of results found, may be empty
+ */
+Results ReadBarcodes(const ImageView& buffer, const DecodeHints& hints, DecodeStats& stats);
+
+/**
+ * Read barcodes from a (very large) ImageView by decoding it in overlapping tiles
+ *
+ * The image is split into tiles of at most tileSize x tileSize pixels, neighboring tiles share overlap pixels. The
+ * overlap has to be at least as big as the largest expected symbol, so that every symbol is completely contained in
+ * at least one tile. The tiles are decoded concurrently, the results are transformed back into image coordinates and
+ * duplicates (symbols found in more than one tile) are removed. The working memory depends on the tile size and the
+ * number of threads, not on the size of the image. This also lifts the 65535 pixel size limit of ReadBarcodes.
+ *
+ * @param buffer  view of the image data including layout and format
+ * @param hints  DecodeHints to parameterize / speed up decoding of each tile
+ * @param tileSize  maximum width and height of a tile in pixels
+ * @param overlap  number of pixels shared by neighboring tiles, needs to be smaller than tileSize
+ * @param numThreads  maximum number of threads to use, 0 means one per hardware thread
+ * @return #Results list of results found, may be empty
+ */
+Results ReadBarcodesTiled(const ImageView& buffer, const DecodeHints& hints, int tileSize, int overlap,
+						  int numThreads = 0);
+
+/**
+ * Throughput counters of ReadBarcodesBatch, they are accumulated over all calls the same object is passed to.
+ */
+struct BatchStats
+{
+	int64_t images = 0;  ///< number of decoded images
+	int64_t symbols = 0; ///< number of found symbols
+	double seconds = 0;  ///< wall clock time spent in ReadBarcodesBatch
+	DecodeStats decode;  ///< per-stage statistics summed over all images (see DecodeStats::IsEnabled())
+
+	double imagesPerSecond() const { return seconds > 0 ? images / seconds : 0; }
+};
+
+/**
+ * Read barcodes from a batch of ImageViews concurrently
+ *
+ * Every worker thread keeps its own reader context (readers and scratch buffers) for the whole batch, so nothing is
+ * reallocated per image unless an image is larger than all previous ones of that thread. The images are handed out
+ * dynamically, largest first, to balance images of very different sizes. If decoding any image throws, the
+ * remaining images are skipped and the exception is rethrown.
+ *
+ * @param images  views of the image data, they need to stay valid until the function returns
+ * @param hints  DecodeHints used for every image
+ * @param numThreads  maximum number of threads to use, 0 means one per hardware thread
+ * @param stats  optional throughput counters that get updated after the batch is done
+ * @return one #Results list per image, in the order of images
+ */
+std::vector<Results> ReadBarcodesBatch(const std::vector<ImageView>& images, const DecodeHints& hints,
+									   int numThreads = 0, BatchStats* stats = nullptr);
+
 } // ZXing
 
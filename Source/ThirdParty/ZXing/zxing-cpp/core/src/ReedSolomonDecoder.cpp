@@ -7,10 +7,12 @@
 
 #include "ReedSolomonDecoder.h"
 
+#include "DecodeStatsSink.h"
 #include "GenericGF.h"
 #include "ZXConfig.h"
 
 #include <algorithm>
+#include <array>
 #include <stdexcept>
 #include <utility>
 
@@ -68,19 +70,52 @@ RunEuclideanAlgorithm(const GenericGF& field, std::vector<int>&& rCoefs, Generic
 	return true;
 }
 
+/**
+ * Chien search: find the roots of the error locator sigma[0] + sigma[1] * x + ... + sigma[degree] * x^degree. Instead
+ * of evaluating it at all field elements, only the inverses of the error locations a^k that correspond to positions in
+ * the message (k < msgLen) are checked and the terms sigma[j] * a^(-j * k) are updated incrementally in the log
+ * domain. The search stops as soon as degree roots have been found.
+ *
+ * @param locations receives the error locations a^k in the order of ascending k
+ * @param scratch buffer of at least 2 * degree ints
+ * @return number of roots found
+ */
+static int
+ChienSearch(const GenericGF& field, const int* sigma, int degree, int msgLen, int* locations, int* scratch)
+{
+	const int n = field.size() - 1;
+	int* logs = scratch;
+	int* steps = scratch + degree;
+	int numTerms = 0;
+	for (int j = 1; j <= degree; ++j)
+		if (sigma[j] != 0) {
+			logs[numTerms] = field.log(sigma[j]);
+			steps[numTerms++] = j % n;
+		}
+
+	int numRoots = 0;
+	for (int k = 0, end = std::min(msgLen, n); k < end && numRoots < degree; ++k) {
+		int value = sigma[0];
+		for (int t = 0; t < numTerms; ++t)
+			value ^= field.exp(logs[t]);
+		if (value == 0)
+			locations[numRoots++] = field.exp(k);
+		for (int t = 0; t < numTerms; ++t) {
+			logs[t] -= steps[t];
+			logs[t] += logs[t] < 0 ? n : 0;
+		}
+	}
+	return numRoots;
+}
+
 static std::vector<int>
-FindErrorLocations(const GenericGF& field, const GenericGFPoly& errorLocator)
+FindErrorLocations(const GenericGF& field, const GenericGFPoly& errorLocator, int msgLen)
 {
-	// This is a direct application of Chien's search
 	int numErrors = errorLocator.degree();
-	std::vector<int> res;
-	res.reserve(numErrors);
-
-	for (int i = 1; i < field.size() && Size(res) < numErrors; i++)
-		if (errorLocator.evaluateAt(i) == 0)
-			res.push_back(field.inverse(i));
+	const auto& coefficients = errorLocator.coefficients(); // most significant first
+	std::vector<int> sigma(coefficients.rbegin(), coefficients.rend()), scratch(2 * numErrors), res(numErrors);
 
-	if (Size(res) != numErrors)
+	if (ChienSearch(field, sigma.data(), numErrors, msgLen, res.data(), scratch.data()) != numErrors)
 		return {}; // Error locator degree does not match number of roots
 
 	return res;
@@ -105,8 +140,8 @@ FindErrorMagnitudes(const GenericGF& field, const GenericGFPoly& errorEvaluator,
 	return res;
 }
 
-bool
-ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
+static bool
+DecodeWithEuclideanAlgorithm(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
 {
 	GenericGFPoly poly(field, message);
 
@@ -123,7 +158,7 @@ ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCo
 	if (!RunEuclideanAlgorithm(field, std::move(syndromes), sigma, omega))
 		return false;
 
-	auto errorLocations = FindErrorLocations(field, sigma);
+	auto errorLocations = FindErrorLocations(field, sigma, Size(message));
 	if (errorLocations.empty())
 		return false;
 
@@ -140,4 +175,118 @@ ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCo
 	return true;
 }
 
+// The largest number of error correction codewords handled by the allocation free decoder below. This covers all
+// QR Code, Data Matrix and MaxiCode symbols and all but the largest Aztec symbols.
+static constexpr int MAX_EC_CODEWORDS = 256;
+
+// evaluate the polynomial with the coefficients c[0] + c[1] * x + ... + c[degree] * x^degree at a
+static int EvaluateAt(const GenericGF& field, const int* c, int degree, int a)
+{
+	int res = c[degree];
+	for (int i = degree - 1; i >= 0; --i)
+		res = field.multiply(res, a) ^ c[i];
+	return res;
+}
+
+/**
+ * Decodes the message with the Berlekamp-Massey algorithm and Forney's formula using only buffers on the stack.
+ *
+ * Whenever there is an error pattern with at most numECCodeWords / 2 errors that explains the syndromes, the error
+ * locator is unique, so this finds the same error locator and evaluator (both normalized to sigma(0) == 1) as the
+ * Euclidean algorithm and the result is identical. If there is none, the Euclidean algorithm either fails as well or
+ * it returns a message that is not a valid code word (its error evaluator has a degree >= the one of the locator),
+ * while this reports a failure. For an odd number of error correction codewords the Euclidean algorithm can find
+ * one more error, which is why the failing cases are left to DecodeWithEuclideanAlgorithm then.
+ */
+static bool
+DoReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
+{
+	const int R = numECCodeWords;
+	if (R > MAX_EC_CODEWORDS)
+		return DecodeWithEuclideanAlgorithm(field, message, R);
+
+	// S[i] = message(a^(i + generatorBase)), computed for all i at once in a single pass over the message
+	std::array<int, MAX_EC_CODEWORDS> S = {};
+	std::array<int, MAX_EC_CODEWORDS> alpha;
+	for (int i = 0; i < R; ++i)
+		alpha[i] = field.exp(i + field.generatorBase());
+	for (int c : message)
+		for (int i = 0; i < R; ++i)
+			S[i] = field.multiply(S[i], alpha[i]) ^ c;
+
+	// if all syndromes are 0 there is no error to correct
+	if (std::all_of(S.begin(), S.begin() + R, [](int c) { return c == 0; }))
+		return true;
+
+	auto undecodable = [&] { return R % 2 == 1 && DecodeWithEuclideanAlgorithm(field, message, R); };
+
+	// Berlekamp-Massey: find the shortest LFSR (error locator sigma of length L) that generates the syndromes
+	std::array<int, MAX_EC_CODEWORDS + 1> sigma = {1}, B = {1}, T;
+	int L = 0, m = 1, b = 1;
+	for (int n = 0; n < R; ++n) {
+		int d = S[n];
+		for (int i = 1; i <= L; ++i)
+			d ^= field.multiply(sigma[i], S[n - i]);
+		if (d == 0) {
+			++m;
+			continue;
+		}
+		int coef = field.multiply(d, field.inverse(b));
+		bool lengthChange = 2 * L <= n;
+		if (lengthChange)
+			T = sigma;
+		for (int i = 0; i + m <= R; ++i)
+			sigma[i + m] ^= field.multiply(coef, B[i]);
+		if (lengthChange) {
+			L = n + 1 - L;
+			B = T;
+			b = d;
+			m = 1;
+		} else {
+			++m;
+		}
+	}
+
+	if (2 * L > R || sigma[L] == 0)
+		return undecodable();
+
+	// error evaluator omega = sigma * S mod x^R, its degree is less than L
+	std::array<int, MAX_EC_CODEWORDS> omega = {};
+	for (int k = 0; k < L; ++k)
+		for (int i = 0; i <= k; ++i)
+			omega[k] ^= field.multiply(sigma[i], S[k - i]);
+
+	// the error locations are the inverses of the roots of sigma
+	std::array<int, MAX_EC_CODEWORDS / 2> errorLocations;
+	std::array<int, MAX_EC_CODEWORDS> scratch;
+	int numErrors = ChienSearch(field, sigma.data(), L, Size(message), errorLocations.data(), scratch.data());
+
+	if (numErrors != L)
+		return undecodable();
+
+	int msgLen = Size(message);
+	for (int i = 0; i < numErrors; ++i) {
+		// Forney's formula
+		int xiInverse = field.inverse(errorLocations[i]);
+		int denom = 1;
+		for (int j = 0; j < numErrors; ++j)
+			if (i != j)
+				denom = field.multiply(denom, 1 ^ field.multiply(errorLocations[j], xiInverse));
+		int magnitude = field.multiply(EvaluateAt(field, omega.data(), L - 1, xiInverse), field.inverse(denom));
+		if (field.generatorBase() != 0)
+			magnitude = field.multiply(magnitude, xiInverse);
+
+		message[msgLen - 1 - field.log(errorLocations[i])] ^= magnitude;
+	}
+	return true;
+}
+
+bool
+ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
+{
+	bool success = DoReedSolomonDecode(field, message, numECCodeWords);
+	ZX_STATS_COUNT(ReedSolomonFailures, !success);
+	return success;
+}
+
 } // namespace ZXing
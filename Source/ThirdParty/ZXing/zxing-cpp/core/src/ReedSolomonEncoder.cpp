@@ -7,32 +7,143 @@
 #include "ReedSolomonEncoder.h"
 
 #include "GenericGF.h"
+#include "ZXAlgorithms.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 
 namespace ZXing {
 
+/**
+* The generator polynomial g(x) = (x + a^b)(x + a^(b+1))...(x + a^(b+degree-1)) without its leading 1, i.e. the
+* coefficients of x^(degree-1) down to x^0, in the form the encoder consumes them.
+*/
+struct Generator
+{
+	// logarithms of the coefficients (-1 for a 0 coefficient)
+	std::vector<int> logs;
+	// for fields of up to 256 elements: all multiples of the coefficients, degree values per field element
+	std::vector<int> products;
+};
+
+static Generator BuildGenerator(const GenericGF& field, int degree)
+{
+	std::vector<int> coefficients = {1};
+	for (int d = 0; d < degree; d++) {
+		// multiply by (x + a^(d+b))
+		int root = field.exp(d + field.generatorBase());
+		coefficients.push_back(0);
+		for (int i = d + 1; i > 0; i--)
+			coefficients[i] ^= field.multiply(coefficients[i - 1], root);
+	}
+	coefficients.erase(coefficients.begin());
+
+	Generator res;
+	res.logs.resize(degree);
+	for (int i = 0; i < degree; i++)
+		res.logs[i] = coefficients[i] ? field.log(coefficients[i]) : -1;
+
+	if (field.size() <= 256) {
+		res.products.resize(field.size() * degree);
+		for (int f = 0; f < field.size(); f++)
+			for (int i = 0; i < degree; i++)
+				res.products[f * degree + i] = field.multiply(f, coefficients[i]);
+	}
+	return res;
+}
+
+namespace {
+
+struct GeneratorSlots
+{
+	const GenericGF* field;
+	std::unique_ptr<std::atomic<const Generator*>[]> generators; // indexed by degree
+};
+
+} // namespace
+
+/**
+* Building a generator is O(degree^2) (O(size * degree) with the products table), so it is done only once per field
+* and degree. Every field has a fixed array of slots, one per possible degree. Looking up a generator that has already
+* been built is lock-free, so concurrent encoders do not serialize. Only building a new one takes the lock.
+*/
+static const Generator& CachedGenerator(const GenericGF& field, int degree)
+{
+	static const auto slots = [] {
+		const GenericGF* fields[] = {&GenericGF::AztecData12(), &GenericGF::AztecData10(), &GenericGF::AztecData6(),
+									 &GenericGF::AztecParam(), &GenericGF::QRCodeField256(), &GenericGF::DataMatrixField256(),
+									 &GenericGF::AztecData8(), &GenericGF::MaxiCodeField64()};
+		std::array<GeneratorSlots, std::size(fields)> res;
+		for (size_t i = 0; i < res.size(); i++)
+			res[i] = {fields[i], std::make_unique<std::atomic<const Generator*>[]>(fields[i]->size())};
+		return res;
+	}();
+	static std::mutex mutex;
+	static std::list<Generator> generators; // owns the generators, the nodes are never moved
+
+	auto i = FindIf(slots, [&field](const GeneratorSlots& s) { return s.field == &field; });
+	if (i == slots.end() || degree <= 0 || degree >= field.size())
+		throw std::invalid_argument("Invalid number of error correction code words");
+
+	auto& slot = i->generators[degree];
+	if (auto generator = slot.load(std::memory_order_acquire))
+		return *generator;
+
+	std::lock_guard lock(mutex);
+	if (auto generator = slot.load(std::memory_order_relaxed))
+		return *generator;
+	const Generator& generator = generators.emplace_back(BuildGenerator(field, degree));
+	slot.store(&generator, std::memory_order_release);
+	return generator;
+}
+
 ReedSolomonEncoder::ReedSolomonEncoder(const GenericGF& field)
 : _field(&field)
 {
-	_cachedGenerators.push_back(GenericGFPoly(field, { 1 }));
 }
 
-const GenericGFPoly&
-ReedSolomonEncoder::buildGenerator(int degree)
+void
+ReedSolomonEncoder::encode(const int* data, int dataLength, int* ecc, int numECCodeWords) const
 {
-	int cachedGenSize = Size(_cachedGenerators);
-	if (degree >= cachedGenSize) {
-		GenericGFPoly lastGenerator = _cachedGenerators.back();
-		for (int d = cachedGenSize; d <= degree; d++) {
-			lastGenerator.multiply(GenericGFPoly(*_field, { 1, _field->exp(d - 1 + _field->generatorBase()) }));
-			_cachedGenerators.push_back(lastGenerator);
+	const GenericGF& field = *_field;
+	const Generator& generator = CachedGenerator(field, numECCodeWords);
+	const int n = numECCodeWords;
+
+	// The remainder of the division data(x) * x^n / g(x) computed with a linear feedback shift register: per data
+	// code word, the register is shifted by one and the feedback multiplied by g(x) is added.
+	std::fill_n(ecc, n, 0);
+	if (!generator.products.empty()) {
+		// the multiples of g(x) are looked up as a whole, the loop is a plain (vectorizable) shift and xor
+		for (int i = 0; i < dataLength; i++) {
+			const int* product = generator.products.data() + (data[i] ^ ecc[0]) * n;
+			for (int k = 0; k < n - 1; k++)
+				ecc[k] = ecc[k + 1] ^ product[k];
+			ecc[n - 1] = product[n - 1];
+		}
+	} else {
+		const int order = field.size() - 1;
+		const int* logs = generator.logs.data();
+		for (int i = 0; i < dataLength; i++) {
+			int feedback = data[i] ^ ecc[0];
+			std::copy(ecc + 1, ecc + n, ecc);
+			ecc[n - 1] = 0;
+			if (feedback == 0)
+				continue;
+			int logFeedback = field.log(feedback);
+			for (int k = 0; k < n; k++) {
+				if (logs[k] < 0)
+					continue;
+				int l = logFeedback + logs[k];
+				ecc[k] ^= field.exp(l < order ? l : l - order);
+			}
 		}
 	}
-
-	return *std::next(_cachedGenerators.begin(), degree);
 }
 
 void
@@ -41,14 +152,8 @@ ReedSolomonEncoder::encode(std::vector<int>& message, const int numECCodeWords)
 	if (numECCodeWords == 0 || numECCodeWords >= Size(message))
 		throw std::invalid_argument("Invalid number of error correction code words");
 
-	GenericGFPoly info = GenericGFPoly(*_field, std::vector<int>(message.begin(), message.end() - numECCodeWords));
-	info.multiplyByMonomial(1, numECCodeWords);
-	GenericGFPoly _;
-	info.divide(buildGenerator(numECCodeWords), _);
-	auto& coefficients = info.coefficients();
-	int numZeroCoefficients = numECCodeWords - Size(coefficients);
-	std::fill_n(message.end() - numECCodeWords, numZeroCoefficients, 0);
-	std::copy(coefficients.begin(), coefficients.end(), message.end() - numECCodeWords + numZeroCoefficients);
+	int dataLength = Size(message) - numECCodeWords;
+	encode(message.data(), dataLength, message.data() + dataLength, numECCodeWords);
 }
 
 } // ZXing
@@ -6,13 +6,12 @@
 
 #pragma once
 
-#include "GenericGFPoly.h"
-
-#include <list>
 #include <vector>
 
 namespace ZXing {
 
+class GenericGF;
+
 // public only for testing purposes
 class ReedSolomonEncoder
 {
@@ -21,11 +20,14 @@ public:
 
 	void encode(std::vector<int>& message, int numECCodeWords);
 
+	/**
+	 * Compute the numECCodeWords error correction code words of the dataLength data code words in data and store
+	 * them in ecc. The generator polynomials are built once per field and degree and are shared by all encoders.
+	 */
+	void encode(const int* data, int dataLength, int* ecc, int numECCodeWords) const;
+
 private:
 	const GenericGF* _field;
-	std::list<GenericGFPoly> _cachedGenerators;
-
-	const GenericGFPoly& buildGenerator(int degree);
 };
 
 /**
@@ -34,8 +34,9 @@ class Result
 	Result& setDecodeHints(DecodeHints hints);
 
 	friend Result MergeStructuredAppendSequence(const std::vector<Result>& results);
-	friend std::vector<Result> ReadBarcodes(const ImageView&, const DecodeHints&);
+	friend class ReaderContext;
 	friend void IncrementLineCount(Result&);
+	friend class LineScanReader;
 
 public:
 	Result() = default;
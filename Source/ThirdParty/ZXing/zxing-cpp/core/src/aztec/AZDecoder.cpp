@@ -11,6 +11,7 @@
 #include "BitArray.h"
 #include "BitMatrix.h"
 #include "CharacterSet.h"
+#include "DecodeStatsSink.h"
 #include "DecoderResult.h"
 #include "GenericGF.h"
 #include "ReedSolomonDecoder.h"
@@ -347,6 +348,8 @@ DecoderResult Decode(const BitArray& bits)
 
 DecoderResult Decode(const DetectorResult& detectorResult)
 {
+	ZX_STATS_TIMER(Decoding);
+
 	try {
 		auto bits = CorrectBits(detectorResult, ExtractBits(detectorResult));
 		return Decode(bits);
@@ -12,6 +12,7 @@
 #include "DMBitLayout.h"
 #include "DMDataBlock.h"
 #include "DMVersion.h"
+#include "DecodeStatsSink.h"
 #include "DecoderResult.h"
 #include "GenericGF.h"
 #include "ReedSolomonDecoder.h"
@@ -445,6 +446,8 @@ static BitMatrix FlippedL(const BitMatrix& bits)
 
 DecoderResult Decode(const BitMatrix& bits)
 {
+	ZX_STATS_TIMER(Decoding);
+
 	auto res = DoDecode(bits);
 	if (res.isValid())
 		return res;
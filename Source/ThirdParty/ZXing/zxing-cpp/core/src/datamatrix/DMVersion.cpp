@@ -17,7 +17,7 @@ const Version* VersionForDimensions(int height, int width)
 	* See ISO 16022:2006 5.5.1 Table 7
 	* See ISO 21471:2020 (DMRE) 5.5.1 Table 7
 	*/
-	static const Version allVersions[] = {
+	static constexpr Version allVersions[] = {
 		// clang-format off
 		{1, 10, 10, 8, 8,      {5,  {{1, 3  }, {0, 0}}}},
 		{2, 12, 12, 10, 10,    {7,  {{1, 5  }, {0, 0}}}},
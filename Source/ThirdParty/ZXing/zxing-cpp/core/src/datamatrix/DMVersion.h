@@ -34,9 +34,9 @@ public:
 			int dataCodewords;
 		} const blocks[2];
 
-		int numBlocks() const { return blocks[0].count + blocks[1].count; }
+		constexpr int numBlocks() const { return blocks[0].count + blocks[1].count; }
 
-		int totalDataCodewords() const
+		constexpr int totalDataCodewords() const
 		{
 			return blocks[0].count * (blocks[0].dataCodewords + codewordsPerBlock) +
 				   blocks[1].count * (blocks[1].dataCodewords + codewordsPerBlock);
@@ -8,6 +8,7 @@
 
 #include "ByteArray.h"
 #include "CharacterSet.h"
+#include "DecodeStatsSink.h"
 #include "DecoderResult.h"
 #include "GenericGF.h"
 #include "MCBitMatrixParser.h"
@@ -297,6 +298,8 @@ DecoderResult Decode(ByteArray&& bytes, const int mode)
 
 DecoderResult Decode(const BitMatrix& bits)
 {
+	ZX_STATS_TIMER(Decoding);
+
 	ByteArray codewords = BitMatrixParser::ReadCodewords(bits);
 
 	if (!CorrectErrors(codewords, 0, 10, 10, ALL))
@@ -163,39 +163,63 @@ constexpr float QUIET_ZONE = 5;	// quiet zone spec is 10 modules, real world exa
 constexpr int CHAR_SUM = 11;
 
 //TODO: make this a constexpr variable initialization
-static auto E2E_PATTERNS = [] {
-	// This creates an array of ints for fast IndexOf lookup of the edge-2-edge patterns (ISO/IEC 15417:2007(E) Table 2)
-	// e.g. a code pattern of { 2, 1, 2, 2, 2, 2 } becomes the e2e pattern { 3, 3, 4, 4 } and the value 0b11100011110000.
-	std::array<int, 107> res;
-	for (int i = 0; i < Size(res); ++i) {
+static auto E2E_TABLE = [] {
+	// This creates a table for the direct lookup of the edge-2-edge patterns (ISO/IEC 15417:2007(E) Table 2). The index
+	// is the concatenation of the 4 e2e values in 3 bits each, e.g. a code pattern of { 2, 1, 2, 2, 2, 2 } becomes the
+	// e2e pattern { 3, 3, 4, 4 } and the index 03344 (octal).
+	std::array<int8_t, 1 << 12> res;
+	res.fill(-1);
+	for (int i = Size(Code128::CODE_PATTERNS) - 1; i >= 0; --i) {
 		const auto& a = Code128::CODE_PATTERNS[i];
-		std::array<int, 4> e2e;
+		int index = 0;
 		for (int j = 0; j < 4; j++)
-			e2e[j] = a[j] + a[j + 1];
-		res[i] = ToInt(e2e);
+			index = (index << 3) | (a[j] + a[j + 1]);
+		res[index] = narrow_cast<int8_t>(i);
 	}
 	return res;
 }();
 
+static int DecodeE2E(const PatternView& view)
+{
+	int index = 0;
+	for (int e2e : NormalizedE2EPattern<CHAR_LEN, CHAR_SUM>(view)) {
+		if (e2e > 7) // no code pattern has a pair of elements that is wider than 7 modules
+			return -1;
+		index = (index << 3) | e2e;
+	}
+	return E2E_TABLE[index];
+}
+
+// The start symbol is checked completely (not only the common prefix) so that decodePattern() does not have to return
+// to the caller for each false positive prefix found in a row.
+static bool IsStartGuard(const PatternView& window, int spaceInPixel)
+{
+	if (!IsPattern(window, START_PATTERN_PREFIX, spaceInPixel, QUIET_ZONE))
+		return false;
+	int code = DecodeE2E(window);
+	return CODE_START_A <= code && code <= CODE_START_C;
+}
+
 Result Code128Reader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const
 {
 	int minCharCount = 4; // start + payload + checksum + stop
+	static const auto CODE_TABLE = DigitTable<CHAR_LEN>(Code128::CODE_PATTERNS);
 	auto decodePattern = [](const PatternView& view, bool start = false) {
 		// This is basically the reference algorithm from the specification
-		int code = IndexOf(E2E_PATTERNS, ToInt(NormalizedE2EPattern<CHAR_LEN, CHAR_SUM>(view)));
-		if (code == -1 && !start) // if the reference algo fails, give the original upstream version a try (required to decode a few samples)
-			code = DecodeDigit(view, Code128::CODE_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE);
+		int code = DecodeE2E(view);
+		if (code == -1 && !start) { // if the reference algo fails, give the original upstream version a try (required to decode a few samples)
+			code = LookupDigit<CHAR_LEN, CHAR_SUM>(view, CODE_TABLE, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE);
+			if (code == -1)
+				code = DecodeDigit(view, Code128::CODE_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE);
+		}
 		return code;
 	};
 
-	next = FindLeftGuard(next, minCharCount * CHAR_LEN, START_PATTERN_PREFIX, QUIET_ZONE);
+	next = FindLeftGuard<CHAR_LEN>(next, minCharCount * CHAR_LEN, IsStartGuard);
 	if (!next.isValid())
 		return {};
 
-	next = next.subView(0, CHAR_LEN);
 	int startCode = decodePattern(next, true);
-	if (!(CODE_START_A <= startCode && startCode <= CODE_START_C))
-		return {};
 
 	int xStart = next.pixelsInFront();
 	ByteArray rawCodes;
@@ -13,8 +13,12 @@
 #include "ODDataBarExpandedBitDecoder.h"
 #include "Result.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <map>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 namespace ZXing::OneD {
@@ -23,7 +27,8 @@ using namespace DataBar;
 
 static bool IsFinderPattern(int a, int b, int c, int d, int e)
 {
-	return IsFinder(a, b, c, d, e) && (c > 3 * e);
+	// the cheap and selective test first, this runs at every position of the row (in both directions)
+	return (c > 3 * e) && IsFinder(a, b, c, d, e);
 };
 
 static bool IsCharacterPair(const PatternView& v)
@@ -187,8 +192,23 @@ static Pair ReadPair(const PatternView& view, Direction dir)
 	return {};
 }
 
+// On a mirrored row (a reversed row of a stacked symbol or an upside down symbol) a l2r pair still starts on a space but
+// its finder looks like a r2l one and vice versa. The left character follows the finder, the right one might be missing.
+static bool IsMirroredL2RPair(const PatternView& v)
+{
+	return IsFinderPattern(v[12], v[11], v[10], v[9], v[8]) && IsCharacter(v.subView(13, 8), 17, ModSizeFinder(v)) &&
+		   ParseFinderPattern(Finder(v), Direction::Left);
+}
+
+static bool IsMirroredR2LPair(const PatternView& v)
+{
+	return IsFinderPattern(v[8], v[9], v[10], v[11], v[12]) && IsCharacter(v.subView(13, 8), 17, ModSizeFinder(v)) &&
+		   ParseFinderPattern(Finder(v), Direction::Right);
+}
+
+// If mirrored is not null, it is set if a pair of a mirrored row has been spotted while searching for the first pair.
 template<bool STACKED>
-static Pairs ReadRowOfPairs(PatternView& next, int rowNumber)
+static Pairs ReadRowOfPairs(PatternView& next, int rowNumber, bool* mirrored = nullptr)
 {
 	Pairs pairs;
 	Pair pair;
@@ -197,13 +217,20 @@ static Pairs ReadRowOfPairs(PatternView& next, int rowNumber)
 		// a possible first pair is either left2right starting on a space or right2left starting on a bar.
 		// it might be a half-pair
 		next = next.subView(0, HALF_PAIR_SIZE);
+		bool checkMirrored = mirrored != nullptr;
 		while (next.shift(1)) {
 			if (IsL2RPair(next) && (pair = ReadPair(next, Direction::Right)) &&
 				(pair.finder != FINDER_A || IsGuard(next[-1], next[11])))
 				break;
+			if (checkMirrored && next.isValid(FULL_PAIR_SIZE) && IsMirroredL2RPair(next))
+				checkMirrored = false;
 			if (next.shift(1) && IsR2LPair(next) && (pair = ReadPair(next, Direction::Left)))
 				break;
+			if (checkMirrored && next.isValid(FULL_PAIR_SIZE) && IsMirroredR2LPair(next))
+				checkMirrored = false;
 		}
+		if (mirrored)
+			*mirrored = !checkMirrored;
 	} else {
 		// the only possible first pair is a full, left2right FINDER_A pair starting on a space
 		// with a guard bar on the left
@@ -234,16 +261,52 @@ static Pairs ReadRowOfPairs(PatternView& next, int rowNumber)
 	return pairs;
 }
 
+/**
+ * Reads the pairs of all mirrored rows between begin and end. The part of the row is reversed, so these can be read
+ * like the upright ones. Their positions are mapped back, i.e. their xStart is right of their xStop afterwards.
+ */
+static void ReadMirroredRowsOfPairs(const PatternView& begin, const PatternView& end, int rowNumber, std::vector<Pairs>& rows)
+{
+	// Extend the part by one element on both sides for the guard patterns. A PatternRow starts and ends with a space,
+	// i.e. an element at an even offset from the base.
+	auto base = begin.data() - (begin.index() + 1);
+	auto rowEnd = begin;
+	rowEnd.extend();
+	auto first = std::max(begin.data() - 1, base);
+	first -= (first - base) % 2;
+	auto last = std::min((end.isValid() ? end.end() : rowEnd.end()) + 1, rowEnd.end());
+	last += (last - base) % 2 == 0;
+
+	thread_local PatternRow reversed;
+	reversed.assign(std::make_reverse_iterator(last), std::make_reverse_iterator(first));
+	const int xEnd = std::accumulate(base, last, 0);
+
+	PatternView next(reversed);
+	while (next.isValid() && next.size()) {
+		auto pairs = ReadRowOfPairs<true>(next, rowNumber);
+		if (pairs.empty())
+			break;
+		for (auto& p : pairs) {
+			p.xStart = xEnd - 1 - p.xStart;
+			p.xStop = xEnd - 1 - p.xStop;
+		}
+		rows.push_back(std::move(pairs));
+		// continue on the next bar behind the last pair, see DecodeLines in ODReader.cpp
+		next.shift(2 - (next.index() % 2));
+		next.extend();
+	}
+}
+
 using PairMap = std::map<int, Pairs>;
 
 // inserts all pairs inside row into the PairMap or increases their count respectively.
-static bool Insert(PairMap& all, Pairs&& row)
+static bool Insert(PairMap& all, const Pairs& row)
 {
 	bool res = false;
 	for (const Pair& pair : row) {
 		auto& pairs = all[pair.finder];
 		if (auto i = Find(pairs, pair); i != pairs.end()) {
-			i->count++;
+			i->count += pair.count;
 			// bubble sort the pairs with the highest view count to the front so we test them first in FindValidSequence
 			while (i != pairs.begin() && i[0].count > i[-1].count) {
 				std::swap(i[-1], i[0]);
@@ -325,11 +388,85 @@ static BitArray BuildBitArray(const Pairs& pairs)
 	return res;
 }
 
-struct DBERState : public RowReader::DecodingState
+/**
+ * All pairs seen so far that probably belong to the same symbol, i.e. the rows they have been read on overlap in x and
+ * are close to each other in y. This keeps partial symbols that are next to each other apart.
+ */
+struct Stack
 {
 	PairMap allPairs;
+	int xMin, xMax, yMin, yMax;
+	bool updated = false;
 };
 
+struct DBERState : public RowReader::DecodingState
+{
+	std::vector<Stack> stacks;
+};
+
+// inserts a row of pairs into the stack it belongs to (merging all stacks it connects) or into a new one
+static void Insert(std::vector<Stack>& stacks, const Pairs& row)
+{
+	int xMin = std::numeric_limits<int>::max(), xMax = 0, pairSize = 0;
+	for (const auto& p : row) {
+		UpdateMinMax(xMin, xMax, std::min(p.xStart, p.xStop));
+		UpdateMinMax(xMin, xMax, std::max(p.xStart, p.xStop));
+		pairSize = std::max(pairSize, std::abs(p.xStop - p.xStart));
+	}
+	const int y = row.front().y;
+	// the rows of a stacked symbol are less than a pair wide, allow for one missed row
+	const int maxGap = 2 * pairSize;
+
+	Stack* stack = nullptr;
+	for (auto s = stacks.begin(); s != stacks.end();) {
+		if (xMin > s->xMax || xMax < s->xMin || y < s->yMin - maxGap || y > s->yMax + maxGap) {
+			++s;
+		} else if (!stack) {
+			stack = &*s++;
+		} else {
+			for (const auto& [finder, pairs] : s->allPairs)
+				Insert(stack->allPairs, pairs);
+			UpdateMinMax(stack->xMin, stack->xMax, s->xMin);
+			UpdateMinMax(stack->xMin, stack->xMax, s->xMax);
+			UpdateMinMax(stack->yMin, stack->yMax, s->yMin);
+			UpdateMinMax(stack->yMin, stack->yMax, s->yMax);
+			stack->updated |= s->updated;
+			// stack points in front of s, so it stays valid
+			s = stacks.erase(s);
+		}
+	}
+	if (!stack)
+		stack = &stacks.emplace_back(Stack{{}, xMin, xMax, y, y});
+
+	Insert(stack->allPairs, row);
+	UpdateMinMax(stack->xMin, stack->xMax, xMin);
+	UpdateMinMax(stack->xMin, stack->xMax, xMax);
+	UpdateMinMax(stack->yMin, stack->yMax, y);
+	stack->updated = true;
+}
+
+// EstimatePosition and EstimateLineCount expect the pairs in reading direction of the symbol. Its first row always has
+// the upright l2r layout, so if the first pair has been read right to left the whole symbol is upside down.
+static Position EstimatePosition(Pair first, Pair last, int& lineCount)
+{
+	const bool upsideDown = first.xStart > first.xStop;
+	for (auto* p : {&first, &last}) {
+		if (upsideDown) {
+			p->xStart = -p->xStart;
+			p->xStop = -p->xStop;
+		}
+		if (p->xStart > p->xStop) // read on a mirrored row of the symbol
+			std::swap(p->xStart, p->xStop);
+	}
+
+	lineCount = EstimateLineCount(first, last);
+	auto position = DataBar::EstimatePosition(first, last);
+	if (upsideDown)
+		for (auto& p : position)
+			p.x = -p.x;
+	return position;
+}
+
 Result DataBarExpandedReader::decodePattern(int rowNumber, PatternView& view,
 											std::unique_ptr<RowReader::DecodingState>& state) const
 {
@@ -341,7 +478,7 @@ Result DataBarExpandedReader::decodePattern(int rowNumber, PatternView& view,
 #else
 	if (!state)
 		state.reset(new DBERState);
-	auto& allPairs = static_cast<DBERState*>(state.get())->allPairs;
+	auto& stacks = static_cast<DBERState*>(state.get())->stacks;
 
 	// Stacked codes can be laid out in a number of ways. The following rules apply:
 	//  * the first row starts with FINDER_A in left-to-right (l2r) layout
@@ -355,12 +492,30 @@ Result DataBarExpandedReader::decodePattern(int rowNumber, PatternView& view,
 	// 3 examples: (r == l2r, l == r2l, R/L == r/l but reversed)
 	//    r l r l    |    r l     |     r l r
 	//    L R L R    |    r       |     l
-
-	if (!Insert(allPairs, ReadRowOfPairs<true>(view, rowNumber)))
-		return {};
-
-	auto pairs = FindValidSequence(allPairs);
-	if (pairs.empty())
+	//
+	// The reversed rows (and upside down symbols) are read in the same pass: if the search for the first pair comes
+	// across a mirrored pair, only the part of the row that has been searched is reversed and read again.
+
+	std::vector<Pairs> rows;
+	auto begin = view;
+	bool mirrored = false;
+	if (auto row = ReadRowOfPairs<true>(view, rowNumber, &mirrored); !row.empty())
+		rows.push_back(std::move(row));
+	if (mirrored)
+		ReadMirroredRowsOfPairs(begin, view, rowNumber, rows);
+
+	for (const auto& row : rows)
+		Insert(stacks, row);
+
+	// look for a complete symbol in the stacks that got new pairs (since they have been checked the last time)
+	Stack* stack = nullptr;
+	Pairs pairs;
+	for (auto& s : stacks)
+		if (std::exchange(s.updated, false) && !(pairs = FindValidSequence(s.allPairs)).empty()) {
+			stack = &s;
+			break;
+		}
+	if (!stack)
 		return {};
 #endif
 
@@ -368,14 +523,15 @@ Result DataBarExpandedReader::decodePattern(int rowNumber, PatternView& view,
 	if (txt.empty())
 		return {};
 
-	RemovePairs(allPairs, pairs);
+	RemovePairs(stack->allPairs, pairs);
 
 	// TODO: EstimatePosition misses part of the symbol in the stacked case where the last row contains less pairs than
 	// the first
+	int lineCount = 0;
+	auto position = EstimatePosition(pairs.front(), pairs.back(), lineCount);
 	// Symbology identifier: ISO/IEC 24724:2011 Section 9 and GS1 General Specifications 5.1.3 Figure 5.1.3-2
-	return {DecoderResult(Content(ByteArray(txt), {'e', '0', 0, AIFlag::GS1}))
-				.setLineCount(EstimateLineCount(pairs.front(), pairs.back())),
-			EstimatePosition(pairs.front(), pairs.back()), BarcodeFormat::DataBarExpanded};
+	return {DecoderResult(Content(ByteArray(txt), {'e', '0', 0, AIFlag::GS1})).setLineCount(lineCount), std::move(position),
+			BarcodeFormat::DataBarExpanded};
 }
 
 } // namespace ZXing::OneD
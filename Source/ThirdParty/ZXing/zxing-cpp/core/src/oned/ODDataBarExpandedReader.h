@@ -20,6 +20,8 @@ public:
 	using RowReader::RowReader;
 
 	Result decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const override;
+	bool isStateful() const override { return true; }
+	bool readsUpsideDown() const override { return true; }
 };
 
 } // namespace ZXing::OneD
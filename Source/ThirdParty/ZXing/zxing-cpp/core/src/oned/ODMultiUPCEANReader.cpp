@@ -49,10 +49,14 @@ static bool DecodeDigit(const PatternView& view, std::string& txt, int* lgPatter
 	// lets false positives creep in quickly.
 	static constexpr float MAX_AVG_VARIANCE = 0.48f;
 	static constexpr float MAX_INDIVIDUAL_VARIANCE = 0.7f;
-
-	int bestMatch =
-		lgPattern ? RowReader::DecodeDigit(view, UPCEANCommon::L_AND_G_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE, false)
-				  : RowReader::DecodeDigit(view, UPCEANCommon::L_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE, false);
+	static const auto L_AND_G_TABLE = RowReader::DigitTable<CHAR_LEN>(UPCEANCommon::L_AND_G_PATTERNS);
+
+	// Well printed digits are looked up directly, only the ambiguous ones are compared to all patterns.
+	int bestMatch = RowReader::LookupDigit<CHAR_LEN, 7>(view, L_AND_G_TABLE, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE);
+	if (bestMatch == -1 || (!lgPattern && bestMatch >= 10))
+		bestMatch = lgPattern
+			? RowReader::DecodeDigit(view, UPCEANCommon::L_AND_G_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE, false)
+			: RowReader::DecodeDigit(view, UPCEANCommon::L_PATTERNS, MAX_AVG_VARIANCE, MAX_INDIVIDUAL_VARIANCE, false);
 	if (bestMatch == -1)
 		return false;
 
@@ -217,6 +221,25 @@ static bool UPCE(PartialResult& res, PatternView begin)
 	return true;
 }
 
+// Only let a left guard through if the right guard (and mid pattern) of at least one of the symbologies is found at the
+// expected position. This is a superset of the first check in EAN13(), EAN8() and UPCE() and saves decodePattern() the
+// round trip to the caller for each of the many false positive left guards in a row.
+static bool IsLeftGuard(const PatternView& begin, int spaceInPixel)
+{
+	if (!IsPattern(begin, END_PATTERN, spaceInPixel, QUIET_ZONE_LEFT))
+		return false;
+
+	auto isEAN = [&begin](int midOffset, int endOffset) {
+		auto end = begin.subView(endOffset, END_PATTERN.size());
+		return end.isValid() && IsRightGuard(end, END_PATTERN, QUIET_ZONE_RIGHT_EAN) &&
+			   IsPattern(begin.subView(midOffset, MID_PATTERN.size()), MID_PATTERN);
+	};
+	auto upceEnd = begin.subView(27, UPCE_END_PATTERN.size());
+
+	return isEAN(27, 56) || isEAN(19, 40) ||
+		   (upceEnd.isValid() && IsRightGuard(upceEnd, UPCE_END_PATTERN, QUIET_ZONE_RIGHT_UPC));
+}
+
 static int Ean5Checksum(const std::string& s)
 {
 	int sum = 0, N = Size(s);
@@ -266,7 +289,7 @@ Result MultiUPCEANReader::decodePattern(int rowNumber, PatternView& next, std::u
 {
 	const int minSize = 3 + 6*4 + 6; // UPC-E
 
-	next = FindLeftGuard(next, minSize, END_PATTERN, QUIET_ZONE_LEFT);
+	next = FindLeftGuard<END_PATTERN.size()>(next, minSize, IsLeftGuard);
 	if (!next.isValid())
 		return {};
 
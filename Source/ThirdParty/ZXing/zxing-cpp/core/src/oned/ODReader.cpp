@@ -8,7 +8,9 @@
 #include "ODReader.h"
 
 #include "BinaryBitmap.h"
+#include "BitMatrix.h"
 #include "DecodeHints.h"
+#include "DecodeStatsSink.h"
 #include "ODCodabarReader.h"
 #include "ODCode128Reader.h"
 #include "ODCode39Reader.h"
@@ -17,13 +19,15 @@
 #include "ODDataBarReader.h"
 #include "ODITFReader.h"
 #include "ODMultiUPCEANReader.h"
+#include "Parallel.h"
 #include "Result.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <utility>
 
 #ifdef PRINT_DEBUG
-#include "BitMatrix.h"
 #include "BitMatrixIO.h"
 #endif
 
@@ -38,33 +42,225 @@ void IncrementLineCount(Result& r)
 
 namespace ZXing::OneD {
 
-Reader::Reader(const DecodeHints& hints) : ZXing::Reader(hints)
+RowReaders CreateRowReaders(const DecodeHints& hints)
 {
-	_readers.reserve(8);
+	RowReaders readers;
+	readers.reserve(8);
 
 	auto formats = hints.formats().empty() ? BarcodeFormat::Any : hints.formats();
 
 	if (formats.testFlags(BarcodeFormat::EAN13 | BarcodeFormat::UPCA | BarcodeFormat::EAN8 | BarcodeFormat::UPCE))
-		_readers.emplace_back(new MultiUPCEANReader(hints));
+		readers.emplace_back(new MultiUPCEANReader(hints));
 
 	if (formats.testFlag(BarcodeFormat::Code39))
-		_readers.emplace_back(new Code39Reader(hints));
+		readers.emplace_back(new Code39Reader(hints));
 	if (formats.testFlag(BarcodeFormat::Code93))
-		_readers.emplace_back(new Code93Reader(hints));
+		readers.emplace_back(new Code93Reader(hints));
 	if (formats.testFlag(BarcodeFormat::Code128))
-		_readers.emplace_back(new Code128Reader(hints));
+		readers.emplace_back(new Code128Reader(hints));
 	if (formats.testFlag(BarcodeFormat::ITF))
-		_readers.emplace_back(new ITFReader(hints));
+		readers.emplace_back(new ITFReader(hints));
 	if (formats.testFlag(BarcodeFormat::Codabar))
-		_readers.emplace_back(new CodabarReader(hints));
+		readers.emplace_back(new CodabarReader(hints));
 	if (formats.testFlags(BarcodeFormat::DataBar))
-		_readers.emplace_back(new DataBarReader(hints));
+		readers.emplace_back(new DataBarReader(hints));
 	if (formats.testFlags(BarcodeFormat::DataBarExpanded))
-		_readers.emplace_back(new DataBarExpandedReader(hints));
+		readers.emplace_back(new DataBarExpandedReader(hints));
+
+	return readers;
 }
 
+Reader::Reader(const DecodeHints& hints) : ZXing::Reader(hints), _readers(CreateRowReaders(hints)) {}
+
 Reader::~Reader() = default;
 
+/**
+ * Runs reader on one direction of a row and calls onLine(Result&&) for every line result, after it has been transformed
+ * into image coordinates. Returns true as soon as onLine does.
+ */
+template <typename F>
+static bool DecodeLines(const RowReader& reader, std::unique_ptr<RowReader::DecodingState>& state, int rowNumber,
+						const PatternRow& bars, int width, bool upsideDown, bool rotate, bool tryHarder, bool returnErrors,
+						F&& onLine)
+{
+	PatternView next(bars);
+	do {
+		Result result = reader.decodePattern(rowNumber, next, state);
+		if (result.isValid() || (returnErrors && result.error())) {
+			IncrementLineCount(result);
+			if (upsideDown) {
+				// update position (flip horizontally).
+				auto points = result.position();
+				for (auto& p : points) {
+					p = {width - p.x - 1, p.y};
+				}
+				result.setPosition(std::move(points));
+			}
+			if (rotate) {
+				auto points = result.position();
+				for (auto& p : points) {
+					p = {p.y, width - p.x - 1};
+				}
+				result.setPosition(std::move(points));
+			}
+
+			if (onLine(std::move(result)))
+				return true;
+		}
+		// make sure we make progress and we start the next try on a bar
+		next.shift(2 - (next.index() % 2));
+		next.extend();
+	} while (tryHarder && next.size());
+
+	return false;
+}
+
+/**
+ * Merges a line result into a matching symbol in res or appends it as a new one, see DecodeRow.
+ */
+static bool MergeLine(Results& res, Result&& result, bool rotate, const std::function<bool(int index, bool isNew)>& onLine)
+{
+	// check if we know this code already
+	auto known = FindIf(res, [&result](const Result& other) { return result == other; });
+	bool isNew = known == res.end();
+	if (!isNew) {
+		auto& other = *known;
+		// merge the position information
+		auto dTop = maxAbsComponent(other.position().topLeft() - result.position().topLeft());
+		auto dBot = maxAbsComponent(other.position().bottomLeft() - result.position().topLeft());
+		auto points = other.position();
+		if (dTop < dBot || (dTop == dBot && rotate ^ (sumAbsComponent(points[0]) >
+													  sumAbsComponent(result.position()[0])))) {
+			points[0] = result.position()[0];
+			points[1] = result.position()[1];
+		} else {
+			points[2] = result.position()[2];
+			points[3] = result.position()[3];
+		}
+		other.setPosition(points);
+		IncrementLineCount(other);
+	} else {
+		known = res.insert(res.end(), std::move(result));
+	}
+
+	return onLine(narrow_cast<int>(known - res.begin()), isNew);
+}
+
+/**
+ * The line results of all readers that are not stateful, for both directions of one row. They are collected
+ * concurrently for many rows and merged afterwards, see DoDecode.
+ */
+struct RowScan
+{
+	bool hasBars = false;
+	PatternRow bars; // in original (not reversed) order
+	std::vector<Results> lines; // index: upsideDown * readers.size() + reader
+};
+
+static void ScanRow(const RowReaders& readers, int rowNumber, int width, bool rotate, bool tryHarder, bool returnErrors,
+					RowScan& scan)
+{
+	scan.lines.resize(2 * readers.size());
+	for (auto& lines : scan.lines)
+		lines.clear();
+	if (!scan.hasBars)
+		return;
+
+	auto isStateful = [](const auto& reader) { return reader->isStateful(); };
+	if (std::all_of(readers.begin(), readers.end(), isStateful))
+		return;
+	// the bars are only needed in original order afterwards if there are stateful readers left to run on them
+	bool hasStateful = std::any_of(readers.begin(), readers.end(), isStateful);
+
+	std::unique_ptr<RowReader::DecodingState> noState;
+	for (bool upsideDown : {false, true}) {
+		if (upsideDown)
+			std::reverse(scan.bars.begin(), scan.bars.end());
+		for (size_t r = 0; r < readers.size(); ++r)
+			if (!readers[r]->isStateful() && !(upsideDown && readers[r]->readsUpsideDown()))
+				DecodeLines(*readers[r], noState, rowNumber, scan.bars, width, upsideDown, rotate, tryHarder, returnErrors,
+							[&lines = scan.lines[upsideDown * readers.size() + r]](Result&& line) {
+								lines.push_back(std::move(line));
+								return false;
+							});
+	}
+	if (hasStateful)
+		std::reverse(scan.bars.begin(), scan.bars.end());
+}
+
+/**
+ * Implementation of DecodeRow. If scan is not null, the line results of the readers that are not stateful are taken from
+ * it instead of decoding them here. This way the merging happens in the same order in both cases.
+ */
+static bool DecodeRow(const RowReaders& readers, DecodingStates& states, int rowNumber, PatternRow& bars, int width,
+					  bool rotate, bool tryHarder, bool statefulOnly, bool returnErrors, Results& res,
+					  const std::function<bool(int index, bool isNew)>& onLine, RowScan* scan)
+{
+	// While we have the image data in a PatternRow, it's fairly cheap to reverse it in place to
+	// handle decoding upside down barcodes. This is only done once a reader actually needs to see it, so the bars are
+	// left untouched if all line results come from a RowScan or no reader is run in the pure case.
+	// TODO: the DataBar (stacked) decoder depends on seeing each line from both directions. This is 'surprising' and
+	// inconsistent. It also requires the decoderState to be shared between normal and reversed scans. The
+	// DataBarExpanded decoder reads mirrored rows on its own (see RowReader::readsUpsideDown). See also
+	// https://github.com/zxing-cpp/zxing-cpp/issues/87
+	bool isReversed = false;
+	for (bool upsideDown : {false, true}) {
+		// Look for a barcode
+		for (size_t r = 0; r < readers.size(); ++r) {
+			// If this is a pure symbol, then checking a single non-empty line is sufficient for all but the stacked
+			// DataBar codes. They are the only ones using the decodingState, which we can use as a flag here.
+			if ((statefulOnly && !states[r]) || (upsideDown && readers[r]->readsUpsideDown()))
+				continue;
+
+			auto mergeLine = [&](Result&& line) { return MergeLine(res, std::move(line), rotate, onLine); };
+
+			if (scan && !readers[r]->isStateful()) {
+				for (auto& line : scan->lines[upsideDown * readers.size() + r])
+					if (mergeLine(std::move(line)))
+						return true;
+				continue;
+			}
+
+			// trying again? reverse the row and continue
+			if (upsideDown != isReversed) {
+				std::reverse(bars.begin(), bars.end());
+				isReversed = true;
+			}
+
+			if (DecodeLines(*readers[r], states[r], rowNumber, bars, width, upsideDown, rotate, tryHarder, returnErrors,
+							mergeLine))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+bool DecodeRow(const RowReaders& readers, DecodingStates& states, int rowNumber, PatternRow& bars, int width,
+			   bool rotate, bool tryHarder, bool statefulOnly, bool returnErrors, Results& res,
+			   const std::function<bool(int index, bool isNew)>& onLine)
+{
+	return DecodeRow(readers, states, rowNumber, bars, width, rotate, tryHarder, statefulOnly, returnErrors, res, onLine,
+					 nullptr);
+}
+
+static void RemoveWeakSymbols(Results& res, int minLineCount)
+{
+	// remove all symbols with insufficient line count
+	auto it = std::remove_if(res.begin(), res.end(), [&](auto&& r) { return r.lineCount() < minLineCount; });
+	res.erase(it, res.end());
+
+	// if symbols overlap, remove the one with a lower line count
+	for (auto a = res.begin(); a != res.end(); ++a)
+		for (auto b = std::next(a); b != res.end(); ++b)
+			if (HaveIntersectingBoundingBoxes(a->position(), b->position()))
+				*(a->lineCount() < b->lineCount() ? a : b) = Result();
+
+	//TODO: C++20 res.erase_if()
+	it = std::remove_if(res.begin(), res.end(), [](auto&& r) { return r.format() == BarcodeFormat::None; });
+	res.erase(it, res.end());
+}
+
 /**
 * We're going to examine rows from the middle outward, searching alternately above and below the
 * middle, and farther out each time. rowStep is the number of rows between each successive
@@ -74,12 +270,14 @@ Reader::~Reader() = default;
 * decided that moving up and down by about 1/16 of the image is pretty good; we try more of the
 * image if "trying harder".
 */
-static Results DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers, const BinaryBitmap& image,
-						bool tryHarder, bool rotate, bool isPure, int maxSymbols, int minLineCount, bool returnErrors)
+static Results DoDecode(const RowReaders& readers, const BinaryBitmap& image, bool tryHarder, bool rotate, bool isPure,
+						int maxSymbols, int minLineCount, bool returnErrors, int numThreads, bool subPixelEdges)
 {
+	ZX_STATS_TIMER(Decoding);
+
 	Results res;
 
-	std::vector<std::unique_ptr<RowReader::DecodingState>> decodingState(readers.size());
+	DecodingStates decodingState(readers.size());
 
 	int width = image.width();
 	int height = image.height();
@@ -94,23 +292,63 @@ static Results DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 		height :	// Look at the whole image, not just the center
 		15;			// 15 rows spaced 1/32 apart is roughly the middle half of the image
 
+	// Scanning from the middle out. Determine which row we're looking at in step i:
+	auto scanRowNumber = [&](int i) {
+		int rowStepsAboveOrBelow = (i + 1) / 2;
+		bool isAbove = (i & 0x01) == 0; // i.e. is x even?
+		return middle + rowStep * (isAbove ? rowStepsAboveOrBelow : -rowStepsAboveOrBelow);
+	};
+
 	if (isPure)
 		minLineCount = 1;
 	std::vector<int> checkRows;
 
+	// With sub-pixel edges the rows are decoded in a virtual image that is scaled by scale in both directions, so the
+	// widths can be given in fixed-point. The positions are mapped back (and rotated) after the scan. A scale below 4
+	// leaves no room to move an edge by a fraction of a pixel (see RefineEdges), so wider rows are read as usual.
+	const int maxScale = subPixelEdges ? std::min(0xffff / std::max(1, width), 8) : 1;
+	const int scale = maxScale >= 4 ? maxScale : 1;
+	auto getPatternRow = [&](int rowNumber, PatternRow& res) {
+		return scale > 1 ? image.getSubPixelPatternRow(rowNumber, rotate ? 90 : 0, scale, res)
+						 : image.getPatternRow(rowNumber, rotate ? 90 : 0, res);
+	};
+
 	PatternRow bars;
 	bars.reserve(128); // e.g. EAN-13 has 59 bars/spaces
 
+	// With more than one thread, the rows are binarized and decoded by the readers that are not stateful in batches of
+	// tasks ahead of time (see RowScan). The loop below merges them in the original scan order, runs the stateful readers
+	// (which keep their single DecodingState across batches) and scans the check rows, so the result is the same as
+	// with a single thread. Stopping early (maxSymbols) wastes at most the rest of the current batch.
+	// Every task should have enough pixels to make up for the overhead of the thread.
+	const int rowsPerTask = std::max(8, (1 << 16) / std::max(1, width));
+	int numRows = 0; // number of steps until the scan runs off the top or bottom
+	while (numRows < maxLines && scanRowNumber(numRows) >= 0 && scanRowNumber(numRows) < height)
+		++numRows;
+	const int numWorkers = isPure || numThreads == 1 ? 1 : NumWorkerThreads(numThreads, numRows / rowsPerTask);
+	std::vector<RowScan> scans(numWorkers > 1 ? 2 * numWorkers * rowsPerTask : 0);
+	int scansBegin = 0, scansEnd = 0; // the range of steps i that scans currently holds
+
+	auto scanRows = [&](int begin) {
+		scansBegin = begin;
+		scansEnd = std::min(numRows, begin + Size(scans));
+		ParallelFor((scansEnd - scansBegin + rowsPerTask - 1) / rowsPerTask, numWorkers, [&](int task, int) {
+			for (int i = scansBegin + task * rowsPerTask; i < std::min(scansEnd, scansBegin + (task + 1) * rowsPerTask); ++i) {
+				int rowNumber = scanRowNumber(i);
+				auto& scan = scans[i - scansBegin];
+				scan.hasBars = getPatternRow(rowNumber, scan.bars);
+				ScanRow(readers, rowNumber * scale, width * scale, rotate && scale == 1, tryHarder, returnErrors, scan);
+			}
+		});
+	};
+
 #ifdef PRINT_DEBUG
 	BitMatrix dbg(width, height);
 #endif
 
 	for (int i = 0; i < maxLines; i++) {
 
-		// Scanning from the middle out. Determine which row we're looking at next:
-		int rowStepsAboveOrBelow = (i + 1) / 2;
-		bool isAbove = (i & 0x01) == 0; // i.e. is x even?
-		int rowNumber = middle + rowStep * (isAbove ? rowStepsAboveOrBelow : -rowStepsAboveOrBelow);
+		int rowNumber = scanRowNumber(i);
 		bool isCheckRow = false;
 		if (rowNumber < 0 || rowNumber >= height) {
 			// Oops, if we run off the top or bottom, stop
@@ -127,122 +365,63 @@ static Results DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 				continue;
 		}
 
-		if (!image.getPatternRow(rowNumber, rotate ? 90 : 0, bars))
-			continue;
+		RowScan* scan = nullptr;
+		if (!scans.empty() && !isCheckRow) {
+			if (i >= scansEnd)
+				scanRows(i);
+			scan = &scans[i - scansBegin];
+			if (!scan->hasBars)
+				continue;
+		} else {
+			ZX_STATS_TIMER(Binarization);
+			if (!getPatternRow(rowNumber, bars))
+				continue;
+		}
+		ZX_STATS_COUNT(RowsScanned, 1);
+
+		auto& rowBars = scan ? scan->bars : bars;
 
 #ifdef PRINT_DEBUG
 		bool val = false;
 		int x = 0;
-		for (auto b : bars) {
-			for(int j = 0; j < b; ++j)
-				dbg.set(x++, rowNumber, val);
+		for (auto b : rowBars) {
+			for(int j = 0; j < b; ++j, ++x)
+				dbg.set(x / scale, rowNumber, val);
 			val = !val;
 		}
 #endif
 
-		// While we have the image data in a PatternRow, it's fairly cheap to reverse it in place to
-		// handle decoding upside down barcodes.
-		// TODO: the DataBarExpanded (stacked) decoder depends on seeing each line from both directions. This
-		// 'surprising' and inconsistent. It also requires the decoderState to be shared between normal and reversed
-		// scans, which makes no sense in general because it would mix partial detection data from two codes of the same
-		// type next to each other. See also https://github.com/zxing-cpp/zxing-cpp/issues/87
-		for (bool upsideDown : {false, true}) {
-			// trying again?
-			if (upsideDown) {
-				// reverse the row and continue
-				std::reverse(bars.begin(), bars.end());
-			}
-			// Look for a barcode
-			for (size_t r = 0; r < readers.size(); ++r) {
-				// If this is a pure symbol, then checking a single non-empty line is sufficient for all but the stacked
-				// DataBar codes. They are the only ones using the decodingState, which we can use as a flag here.
-				if (isPure && i && !decodingState[r])
-					continue;
-
-				PatternView next(bars);
-				do {
-					Result result = readers[r]->decodePattern(rowNumber, next, decodingState[r]);
-					if (result.isValid() || (returnErrors && result.error())) {
-						IncrementLineCount(result);
-						if (upsideDown) {
-							// update position (flip horizontally).
-							auto points = result.position();
-							for (auto& p : points) {
-								p = {width - p.x - 1, p.y};
-							}
-							result.setPosition(std::move(points));
-						}
-						if (rotate) {
-							auto points = result.position();
-							for (auto& p : points) {
-								p = {p.y, width - p.x - 1};
-							}
-							result.setPosition(std::move(points));
-						}
-
-						// check if we know this code already
-						for (auto& other : res) {
-							if (result == other) {
-								// merge the position information
-								auto dTop = maxAbsComponent(other.position().topLeft() - result.position().topLeft());
-								auto dBot = maxAbsComponent(other.position().bottomLeft() - result.position().topLeft());
-								auto points = other.position();
-								if (dTop < dBot || (dTop == dBot && rotate ^ (sumAbsComponent(points[0]) >
-																			  sumAbsComponent(result.position()[0])))) {
-									points[0] = result.position()[0];
-									points[1] = result.position()[1];
-								} else {
-									points[2] = result.position()[2];
-									points[3] = result.position()[3];
-								}
-								other.setPosition(points);
-								IncrementLineCount(other);
-								// clear the result, so we don't insert it again below
-								result = Result();
-								break;
-							}
-						}
-
-						if (result.format() != BarcodeFormat::None) {
-							res.push_back(std::move(result));
-
-							// if we found a valid code we have not seen before but a minLineCount > 1,
-							// add additional check rows above and below the current one
-							if (!isCheckRow && minLineCount > 1 && rowStep > 1) {
-								checkRows = {rowNumber - 1, rowNumber + 1};
-								if (rowStep > 2)
-									checkRows.insert(checkRows.end(), {rowNumber - 2, rowNumber + 2});
-							}
-						}
-
-						if (maxSymbols && Reduce(res, 0, [&](int s, const Result& r) {
-											  return s + (r.lineCount() >= minLineCount);
-										  }) == maxSymbols) {
-							goto out;
-						}
-					}
-					// make sure we make progress and we start the next try on a bar
-					next.shift(2 - (next.index() % 2));
-					next.extend();
-				} while (tryHarder && next.size());
-			}
-		}
+		bool done = DecodeRow(readers, decodingState, rowNumber * scale, rowBars, width * scale, rotate && scale == 1,
+							  tryHarder, isPure && i, returnErrors, res,
+							  [&](int, bool isNew) {
+								  // if we found a valid code we have not seen before but a minLineCount > 1,
+								  // add additional check rows above and below the current one
+								  if (isNew && !isCheckRow && minLineCount > 1 && rowStep > 1) {
+									  checkRows = {rowNumber - 1, rowNumber + 1};
+									  if (rowStep > 2)
+										  checkRows.insert(checkRows.end(), {rowNumber - 2, rowNumber + 2});
+								  }
+
+								  return maxSymbols && Reduce(res, 0, [&](int s, const Result& r) {
+														   return s + (r.lineCount() >= minLineCount);
+													   }) == maxSymbols;
+							  }, scan);
+		if (done)
+			break;
 	}
 
-out:
-	// remove all symbols with insufficient line count
-	auto it = std::remove_if(res.begin(), res.end(), [&](auto&& r) { return r.lineCount() < minLineCount; });
-	res.erase(it, res.end());
-
-	// if symbols overlap, remove the one with a lower line count
-	for (auto a = res.begin(); a != res.end(); ++a)
-		for (auto b = std::next(a); b != res.end(); ++b)
-			if (HaveIntersectingBoundingBoxes(a->position(), b->position()))
-				*(a->lineCount() < b->lineCount() ? a : b) = Result();
+	if (scale > 1)
+		for (auto& r : res) {
+			auto points = r.position();
+			for (auto& p : points) {
+				p = p / scale;
+				if (rotate)
+					p = {p.y, width - p.x - 1};
+			}
+			r.setPosition(std::move(points));
+		}
 
-	//TODO: C++20 res.erase_if()
-	it = std::remove_if(res.begin(), res.end(), [](auto&& r) { return r.format() == BarcodeFormat::None; });
-	res.erase(it, res.end());
+	RemoveWeakSymbols(res, minLineCount);
 
 #ifdef PRINT_DEBUG
 	SaveAsPBM(dbg, rotate ? "od-log-r.pnm" : "od-log.pnm");
@@ -251,14 +430,149 @@ out:
 	return res;
 }
 
+/**
+ * A set of parallel scan lines through the binarized image, all with the same angle. They are sampled incrementally
+ * along their major axis (x if the angle is closer to the horizontal, y otherwise) with a fixed-point DDA.
+ *
+ * The lines span a virtual image: x is the coordinate along the major axis and y is the intercept of the line with the
+ * minor axis (at major == 0), shifted to be non-negative. In there all scan lines are horizontal rows, so they can be
+ * decoded and merged just like the rows in DoDecode. Afterwards the positions are mapped back with toImage().
+ */
+class ScanLines
+{
+	bool _transposed;  // the major axis is y
+	int _majorSize, _minorSize;
+	int64_t _slope;    // minor axis increment per major axis step in 16.16 fixed-point
+	int _minIntercept; // intercept of the first line that crosses the image
+	int _numLines;
+
+	int minor(int y, int major) const { return y + _minIntercept + narrow_cast<int>((major * _slope + 0x8000) >> 16); }
+
+public:
+	ScanLines(int width, int height, double degrees)
+	{
+		constexpr auto std_numbers_pi_v = 3.14159265358979323846; // TODO: c++20 <numbers>
+		double angle = degrees * std_numbers_pi_v / 180;
+		_transposed = std::abs(std::sin(angle)) > std::abs(std::cos(angle));
+		_majorSize = _transposed ? height : width;
+		_minorSize = _transposed ? width : height;
+		_slope = std::llround((_transposed ? 1 / std::tan(angle) : std::tan(angle)) * 0x10000);
+		_minIntercept = 0;
+
+		int delta = minor(0, _majorSize - 1); // minor offset of the last pixel of a line
+		_minIntercept = std::min(0, -delta);
+		_numLines = _minorSize + std::abs(delta);
+	}
+
+	int majorSize() const { return _majorSize; }
+	int numLines() const { return _numLines; }
+
+	/// number of lines (intercepts) between two lines that are about spacing pixels apart
+	int step(int spacing) const
+	{
+		return std::max(1, narrow_cast<int>(std::lround(spacing * std::hypot(1.0, _slope / double(0x10000)))));
+	}
+
+	/// samples scan line y into bits (majorSize() elements), pixels outside of the image are white
+	void sample(const BitMatrix& image, int y, std::vector<uint8_t>& bits) const
+	{
+		bits.assign(_majorSize, 0);
+		int64_t minor = int64_t(y + _minIntercept) * 0x10000 + 0x8000;
+		for (int major = 0; major < _majorSize; ++major, minor += _slope) {
+			int m = narrow_cast<int>(minor >> 16);
+			if (m >= 0 && m < _minorSize)
+				bits[major] = _transposed ? image.get(m, major) : image.get(major, m);
+		}
+	}
+
+	PointI toImage(PointI p) const
+	{
+		int m = minor(p.y, p.x);
+		return _transposed ? PointI(m, p.x) : PointI(p.x, m);
+	}
+};
+
+/**
+ * Scans the binarized image along a set of parallel lines at the given angle. The results are in image coordinates.
+ */
+static Results DoDecodeAngled(const RowReaders& readers, const BitMatrix& image, double degrees, bool tryHarder,
+							  int minLineCount, bool returnErrors)
+{
+	ScanLines lines(image.width(), image.height(), degrees);
+	const int step = lines.step(std::max(1, std::min(image.width(), image.height()) / (tryHarder ? 64 : 32)));
+
+	Results res;
+	DecodingStates decodingState(readers.size());
+	std::vector<uint8_t> bits;
+	PatternRow bars;
+	bars.reserve(128);
+
+	for (int y = step / 2; y < lines.numLines(); y += step) {
+		lines.sample(image, y, bits);
+		GetPatternRow(Range(bits), bars);
+		DecodeRow(readers, decodingState, y, bars, lines.majorSize(), false, tryHarder, false, returnErrors, res,
+				  [](int, bool) { return false; });
+	}
+
+	RemoveWeakSymbols(res, minLineCount);
+
+	for (auto& r : res) {
+		auto points = r.position();
+		for (auto& p : points)
+			p = lines.toImage(p);
+		r.setPosition(std::move(points));
+	}
+
+	return res;
+}
+
+/**
+ * Runs DoDecodeAngled for the fan of angles requested by DecodeHints::scanLineAngles and appends all symbols to res
+ * that it does not contain already.
+ */
+static void DecodeAngled(const RowReaders& readers, const BinaryBitmap& image, const DecodeHints& hints, int maxSymbols,
+						 Results& res)
+{
+	auto* bits = image.getBitMatrix();
+	if (!bits || !hints.scanLineAngles() || hints.isPure())
+		return;
+
+	ZX_STATS_TIMER(Decoding);
+
+	// evenly spaced angles between the horizontal and vertical scans, tilted to either side
+	const int numAngles = hints.scanLineAngles();
+	std::vector<Results> fans(2 * numAngles);
+	ParallelFor(Size(fans), hints.maxNumberOfThreads(), [&](int i, int) {
+		double degrees = 90.0 * (i / 2 + 1) / (numAngles + 1);
+		fans[i] = DoDecodeAngled(readers, *bits, i % 2 ? 180 - degrees : degrees, hints.tryHarder(), hints.minLineCount(),
+								 hints.returnErrors());
+	});
+
+	// a symbol tilted in between two angles may be found by both (or by the horizontal or vertical scan as well)
+	for (auto& fan : fans)
+		for (auto& r : fan) {
+			if (maxSymbols && Size(res) >= maxSymbols)
+				return;
+			if (std::none_of(res.begin(), res.end(), [&r](const Result& o) {
+					return o.format() == r.format() && o.bytes() == r.bytes() &&
+						   HaveIntersectingBoundingBoxes(o.position(), r.position());
+				}))
+				res.push_back(std::move(r));
+		}
+}
+
 Result
 Reader::decode(const BinaryBitmap& image) const
 {
-	auto result =
-		DoDecode(_readers, image, _hints.tryHarder(), false, _hints.isPure(), 1, _hints.minLineCount(), _hints.returnErrors());
+	auto result = DoDecode(_readers, image, _hints.tryHarder(), false, _hints.isPure(), 1, _hints.minLineCount(),
+						   _hints.returnErrors(), _hints.maxNumberOfThreads(), _hints.subPixelEdges());
 
 	if (result.empty() && _hints.tryRotate())
-		result = DoDecode(_readers, image, _hints.tryHarder(), true, _hints.isPure(), 1, _hints.minLineCount(), _hints.returnErrors());
+		result = DoDecode(_readers, image, _hints.tryHarder(), true, _hints.isPure(), 1, _hints.minLineCount(),
+						  _hints.returnErrors(), _hints.maxNumberOfThreads(), _hints.subPixelEdges());
+
+	if (result.empty())
+		DecodeAngled(_readers, image, _hints, 1, result);
 
 	return FirstOrDefault(std::move(result));
 }
@@ -266,12 +580,14 @@ Reader::decode(const BinaryBitmap& image) const
 Results Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 {
 	auto resH = DoDecode(_readers, image, _hints.tryHarder(), false, _hints.isPure(), maxSymbols, _hints.minLineCount(),
-						 _hints.returnErrors());
+						 _hints.returnErrors(), _hints.maxNumberOfThreads(), _hints.subPixelEdges());
 	if ((!maxSymbols || Size(resH) < maxSymbols) && _hints.tryRotate()) {
 		auto resV = DoDecode(_readers, image, _hints.tryHarder(), true, _hints.isPure(), maxSymbols - Size(resH),
-							 _hints.minLineCount(), _hints.returnErrors());
+							 _hints.minLineCount(), _hints.returnErrors(), _hints.maxNumberOfThreads(), _hints.subPixelEdges());
 		resH.insert(resH.end(), resV.begin(), resV.end());
 	}
+	if (!maxSymbols || Size(resH) < maxSymbols)
+		DecodeAngled(_readers, image, _hints, maxSymbols, resH);
 	return resH;
 }
 
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include "ODRowReader.h"
 #include "Reader.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -17,7 +19,29 @@ class DecodeHints;
 
 namespace OneD {
 
-class RowReader;
+using RowReaders = std::vector<std::unique_ptr<RowReader>>;
+using DecodingStates = std::vector<std::unique_ptr<RowReader::DecodingState>>;
+
+/**
+ * @brief CreateRowReaders returns the RowReader instances for all linear formats requested by the hints.
+ */
+RowReaders CreateRowReaders(const DecodeHints& hints);
+
+/**
+ * @brief DecodeRow runs all readers on one row of bars/spaces, forwards and reversed (upside down symbols). Readers
+ * that find upside down symbols on their own (see RowReader::readsUpsideDown) only see the forward row.
+ *
+ * Every line result is transformed into image coordinates (width is the length of the row) and either merged into
+ * a matching symbol in res (combining the positions and incrementing the line count) or appended to res as a new
+ * symbol. After each of these steps onLine(index into res, isNew) is called. If it returns true, decoding of the row
+ * is stopped and DecodeRow returns true as well.
+ *
+ * @param bars is reversed in place for the upside down pass, but only if a reader needs to see it
+ * @param statefulOnly only run readers that already have a decoding state (see isPure handling in DoDecode)
+ */
+bool DecodeRow(const RowReaders& readers, DecodingStates& states, int rowNumber, PatternRow& bars, int width,
+			   bool rotate, bool tryHarder, bool statefulOnly, bool returnErrors, Results& res,
+			   const std::function<bool(int index, bool isNew)>& onLine);
 
 class Reader : public ZXing::Reader
 {
@@ -29,7 +53,7 @@ public:
 	Results decode(const BinaryBitmap& image, int maxSymbols) const override;
 
 private:
-	std::vector<std::unique_ptr<RowReader>> _readers;
+	RowReaders _readers;
 };
 
 } // OneD
@@ -13,9 +13,11 @@
 #include "ZXAlgorithms.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <limits>
 #include <memory>
@@ -66,6 +68,18 @@ public:
 
 	virtual Result decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const = 0;
 
+	/**
+	 * Readers that collect partial symbols across rows in their DecodingState (the stacked DataBar ones) return true.
+	 * They have to see the rows one after the other in scan order, all others can decode any row independently.
+	 */
+	virtual bool isStateful() const { return false; }
+
+	/**
+	 * Readers that find upside down symbols (and mirrored rows) in the forward pass on their own return true. They are
+	 * not run on the reversed row (see DecodeRow).
+	 */
+	virtual bool readsUpsideDown() const { return false; }
+
 	/**
 	 * Determines how closely a set of observed counts of runs of black/white values matches a given
 	 * target pattern. This is reported as the ratio of the total variance from the expected pattern
@@ -136,6 +150,57 @@ public:
 		return bestMatch;
 	}
 
+	/**
+	 * @brief DigitTable creates the lookup table for LookupDigit from a list of patterns with LEN elements of 1 to 4
+	 * modules each. The index is the concatenation of the element widths minus 1 in 2 bits each, the value is the
+	 * index of the first pattern with these widths or -1.
+	 */
+	template <int LEN, typename Patterns>
+	static std::array<int8_t, 1 << 2 * LEN> DigitTable(const Patterns& patterns)
+	{
+		static_assert(std::tuple_size_v<Patterns> <= 127, "too many patterns");
+		std::array<int8_t, 1 << 2 * LEN> table;
+		table.fill(-1);
+		for (int i = Size(patterns) - 1; i >= 0; --i) {
+			int index = 0;
+			for (int j = 0; j < LEN; ++j)
+				index = (index << 2) | (patterns[i][j] - 1);
+			table[index] = narrow_cast<int8_t>(i);
+		}
+		return table;
+	}
+
+	/**
+	 * @brief LookupDigit is the fast path of DecodeDigit: it rounds each counter to a whole number of modules and looks
+	 * the result up in a table created by DigitTable.
+	 *
+	 * This is only done if every counter is less than half a module off. Then the rounded pattern has the lowest variance
+	 * of all patterns with the same module count, so if it is in the table and passes the variance limits, DecodeDigit
+	 * would have returned the same index. Otherwise -1 is returned and the caller has to fall back to DecodeDigit.
+	 */
+	template <int LEN, int SUM, typename Table>
+	static int LookupDigit(const PatternView& view, const Table& table, float maxAvgVariance, float maxIndividualVariance)
+	{
+		int total = view.sum(LEN);
+		if (total < SUM)
+			return -1;
+
+		float unitBarWidth = (float)total / SUM;
+		float totalVariance = 0.0f;
+		int index = 0, sum = 0;
+		for (int i = 0; i < LEN; ++i) {
+			int modules = int(view[i] / unitBarWidth + .5f);
+			float variance = std::abs(view[i] - modules * unitBarWidth);
+			if (modules < 1 || modules > 4 || 2 * variance >= unitBarWidth || variance > maxIndividualVariance * unitBarWidth)
+				return -1;
+			totalVariance += variance;
+			sum += modules;
+			index = (index << 2) | (modules - 1);
+		}
+
+		return sum == SUM && totalVariance / total < maxAvgVariance ? table[index] : -1;
+	}
+
 	/**
 	 * @brief NarrowWideThreshold calculates width thresholds to separate narrow and wide bars and spaces.
 	 *
@@ -17,7 +17,16 @@ namespace Pdf417 {
 void
 BarcodeValue::setValue(int value)
 {
-	_values[value] += 1;
+	auto match = [value](auto& v) { return v.first == value; };
+	auto end = _values.begin() + _numValues;
+	if (auto it = std::find_if(_values.begin(), end, match); it != end)
+		it->second++;
+	else if (_numValues < INLINE_VALUES)
+		_values[_numValues++] = {value, 1};
+	else if (auto it = std::find_if(_moreValues.begin(), _moreValues.end(), match); it != _moreValues.end())
+		it->second++;
+	else
+		_moreValues.emplace_back(value, 1);
 }
 
 /**
@@ -27,21 +36,51 @@ BarcodeValue::setValue(int value)
 std::vector<int>
 BarcodeValue::value() const
 {
+	int maxConfidence = 0;
+	for (int i = 0; i < _numValues; i++)
+		maxConfidence = std::max(maxConfidence, _values[i].second);
+	for (auto& [value, count] : _moreValues)
+		maxConfidence = std::max(maxConfidence, count);
+
 	std::vector<int> result;
-	if (!_values.empty()) {
-		int maxConfidence = std::max_element(_values.begin(), _values.end(), [](auto& l, auto& r) { return l.second < r.second; })->second;
-		for (auto [value, count] : _values)
-			if (count == maxConfidence)
-				result.push_back(value);
-	}
+	for (int i = 0; i < _numValues; i++)
+		if (_values[i].second == maxConfidence)
+			result.push_back(_values[i].first);
+	for (auto& [value, count] : _moreValues)
+		if (count == maxConfidence)
+			result.push_back(value);
+	// sorted by value, as the ambiguous values are tried in this order
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+int
+BarcodeValue::uniqueValue() const
+{
+	int result = -1, maxConfidence = 0;
+	auto check = [&](const std::pair<int, int>& v) {
+		if (v.second > maxConfidence)
+			result = v.first, maxConfidence = v.second;
+		else if (v.second == maxConfidence)
+			result = -1;
+	};
+	for (int i = 0; i < _numValues; i++)
+		check(_values[i]);
+	for (auto& v : _moreValues)
+		check(v);
 	return result;
 }
 
 int
 BarcodeValue::confidence(int value) const
 {
-	auto it = _values.find(value);
-	return it != _values.end() ? it->second : 0;
+	for (int i = 0; i < _numValues; i++)
+		if (_values[i].first == value)
+			return _values[i].second;
+	for (auto& [v, count] : _moreValues)
+		if (v == value)
+			return count;
+	return 0;
 }
 
 } // Pdf417
@@ -6,7 +6,8 @@
 
 #pragma once
 
-#include <map>
+#include <array>
+#include <utility>
 #include <vector>
 
 namespace ZXing {
@@ -17,7 +18,12 @@ namespace Pdf417 {
 */
 class BarcodeValue
 {
-	std::map<int, int> _values;
+	// (value, occurrences) pairs. There are rarely more than a few different values, so the first ones are stored
+	// inline and only the remaining ones (if any) need an allocation.
+	static constexpr int INLINE_VALUES = 4;
+	std::array<std::pair<int, int>, INLINE_VALUES> _values;
+	int _numValues = 0;
+	std::vector<std::pair<int, int>> _moreValues;
 
 public:
 	/**
@@ -31,6 +37,14 @@ public:
 	*/
 	std::vector<int> value() const;
 
+	/**
+	* @return the value with the highest occurrence or -1 if no value was set or the maximum is ambiguous, i.e. the
+	* same as value() if that returns exactly one value, but without an allocation
+	*/
+	int uniqueValue() const;
+
+	bool empty() const { return _numValues == 0; }
+
 	int confidence(int value) const;
 };
 
@@ -0,0 +1,59 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BitMatrix.h"
+
+#include <cstdint>
+
+namespace ZXing {
+namespace Pdf417 {
+
+/**
+* Read-only view of a BitMatrix rotated clockwise by 0, 90, 180 or 270 degrees (see BitMatrix::rotate90()), without
+* copying it. The BitMatrix stores one byte per module, so every rotation is a linear mapping of (x, y) to the index
+* of the module. Modules outside the view are white.
+*/
+class BitMatrixView
+{
+	const uint8_t* _origin = nullptr;
+	int _width = 0;
+	int _height = 0;
+	int _strideX = 0;
+	int _strideY = 0;
+
+public:
+	BitMatrixView() = default;
+
+	explicit BitMatrixView(const BitMatrix& bits, int rotation = 0)
+	{
+		const int w = bits.width(), h = bits.height();
+		const uint8_t* data = bits.empty() ? nullptr : bits.row(0).begin();
+		switch (rotation) {
+		case 90: *this = {data + w - 1, h, w, w, -1}; break;
+		case 180: *this = {data + (h - 1) * w + w - 1, w, h, -1, -w}; break;
+		case 270: *this = {data + (h - 1) * w, h, w, -w, 1}; break;
+		default: *this = {data, w, h, 1, w}; break;
+		}
+	}
+
+	int width() const { return _width; }
+	int height() const { return _height; }
+
+	bool get(int x, int y) const
+	{
+		return static_cast<unsigned>(x) < static_cast<unsigned>(_width) && static_cast<unsigned>(y) < static_cast<unsigned>(_height)
+			   && _origin[x * _strideX + y * _strideY];
+	}
+
+private:
+	BitMatrixView(const uint8_t* origin, int width, int height, int strideX, int strideY)
+		: _origin(origin), _width(width), _height(height), _strideX(strideX), _strideY(strideY)
+	{}
+};
+
+} // Pdf417
+} // ZXing
@@ -407,31 +407,50 @@ static constexpr const std::array<uint16_t, 2787> CODEWORD_TABLE = {
 };
 
 
-using RatioTableType = std::array<std::array<float, CodewordDecoder::BARS_IN_MODULE>, SYMBOL_COUNT>;
+// The ratio table is stored transposed (one row per bar), so the errors of a block of symbols can be computed at
+// once. The rows are padded to a multiple of the block size.
+static constexpr int RATIO_BLOCK_SIZE = 32;
+static constexpr int RATIO_BLOCK_COUNT = (SYMBOL_COUNT + RATIO_BLOCK_SIZE - 1) / RATIO_BLOCK_SIZE;
+using RatioTableType = std::array<std::array<float, RATIO_BLOCK_COUNT * RATIO_BLOCK_SIZE>, CodewordDecoder::BARS_IN_MODULE>;
 using ModuleBitCountType = std::array<int, CodewordDecoder::BARS_IN_MODULE>;
 
-static const RatioTableType& GetRatioTable()
-{
-	static constexpr RatioTableType table = []() constexpr {
-		RatioTableType table{};
-		for (int i = 0; i < SYMBOL_COUNT; i++) {
-			int currentSymbol = SYMBOL_TABLE[i];
-			int currentBit = currentSymbol & 0x1;
-			for (int j = 0; j < CodewordDecoder::BARS_IN_MODULE; j++) {
-				float size = 0.0f;
-				while ((currentSymbol & 0x1) == currentBit) {
-					size += 1.0f;
-					currentSymbol >>= 1;
-				}
-				currentBit = currentSymbol & 0x1;
-				table[i][CodewordDecoder::BARS_IN_MODULE - j - 1] = size / CodewordDecoder::MODULES_IN_CODEWORD;
+static constexpr RatioTableType RATIO_TABLE = []() constexpr {
+	RatioTableType table{};
+	for (int i = 0; i < SYMBOL_COUNT; i++) {
+		int currentSymbol = SYMBOL_TABLE[i];
+		int currentBit = currentSymbol & 0x1;
+		for (int j = 0; j < CodewordDecoder::BARS_IN_MODULE; j++) {
+			float size = 0.0f;
+			while ((currentSymbol & 0x1) == currentBit) {
+				size += 1.0f;
+				currentSymbol >>= 1;
 			}
+			currentBit = currentSymbol & 0x1;
+			table[CodewordDecoder::BARS_IN_MODULE - j - 1][i] = size / CodewordDecoder::MODULES_IN_CODEWORD;
 		}
-		return table;
-	}();
-
+	}
 	return table;
-}
+}();
+
+// The bounding box of the ratios of each block (transposed as well). As the symbols are sorted, the ones in a block
+// share their first bars, so the distance to the box is a good lower bound of the error of all symbols in a block.
+struct RatioBounds
+{
+	std::array<std::array<float, RATIO_BLOCK_COUNT>, CodewordDecoder::BARS_IN_MODULE> min, max;
+};
+
+static constexpr RatioBounds RATIO_BOUNDS = []() constexpr {
+	RatioBounds bounds{};
+	for (int k = 0; k < CodewordDecoder::BARS_IN_MODULE; k++)
+		for (int b = 0; b < RATIO_BLOCK_COUNT; b++) {
+			bounds.min[k][b] = bounds.max[k][b] = RATIO_TABLE[k][b * RATIO_BLOCK_SIZE];
+			for (int i = b * RATIO_BLOCK_SIZE; i < std::min((b + 1) * RATIO_BLOCK_SIZE, SYMBOL_COUNT); i++) {
+				bounds.min[k][b] = std::min(bounds.min[k][b], RATIO_TABLE[k][i]);
+				bounds.max[k][b] = std::max(bounds.max[k][b], RATIO_TABLE[k][i]);
+			}
+		}
+	return bounds;
+}();
 
 static ModuleBitCountType SampleBitCounts(const ModuleBitCountType& moduleBitCount)
 {
@@ -472,33 +491,60 @@ static int GetDecodedCodewordValue(const ModuleBitCountType& moduleBitCount)
 
 static int GetClosestDecodedValue(const ModuleBitCountType& moduleBitCount)
 {
-	static const RatioTableType& ratioTable = GetRatioTable();
+	constexpr int N = CodewordDecoder::BARS_IN_MODULE;
 
 	int bitCountSum = Reduce(moduleBitCount);
-	std::array<float, CodewordDecoder::BARS_IN_MODULE> bitCountRatios = {};
+	std::array<float, N> bitCountRatios = {};
 	if (bitCountSum > 1) {
-		for (int i = 0; i < CodewordDecoder::BARS_IN_MODULE; i++) {
+		for (int i = 0; i < N; i++) {
 			bitCountRatios[i] = moduleBitCount[i] / (float)bitCountSum;
 		}
 	}
+
+	// Nearest neighbour search: a block of symbols is only looked at if the lower bound of its errors does not exceed
+	// the best match so far. Rounding is monotonic, so the bound computed in float is never larger than the error of
+	// any symbol of the block computed in float. The inner loops sum up bar by bar, which the compiler turns into SIMD
+	// code. Starting with the block with the lowest bound, ties are resolved in favour of the first symbol, as in a
+	// linear search.
+	std::array<float, RATIO_BLOCK_COUNT> bounds = {};
+	for (int k = 0; k < N; k++) {
+		const float x = bitCountRatios[k];
+		for (int b = 0; b < RATIO_BLOCK_COUNT; b++) {
+			float diff = std::max(std::max(RATIO_BOUNDS.min[k][b] - x, x - RATIO_BOUNDS.max[k][b]), 0.0f);
+			bounds[b] += diff * diff;
+		}
+	}
+
 	float bestMatchError = std::numeric_limits<float>::max();
 	int bestMatch = -1;
-	for (size_t j = 0; j < ratioTable.size(); j++) {
-		float error = 0.0f;
-		auto& ratioTableRow = ratioTable[j];
-		for (int k = 0; k < CodewordDecoder::BARS_IN_MODULE; k++) {
-			float diff = ratioTableRow[k] - bitCountRatios[k];
-			error += diff * diff;
-			if (error >= bestMatchError) {
-				break;
+	auto searchBlock = [&](int b) {
+		const int begin = b * RATIO_BLOCK_SIZE;
+		if (bounds[b] > bestMatchError || (bounds[b] == bestMatchError && begin > bestMatch))
+			return;
+		std::array<float, RATIO_BLOCK_SIZE> errors = {};
+		for (int k = 0; k < N; k++) {
+			const float* ratios = RATIO_TABLE[k].data() + begin;
+			const float x = bitCountRatios[k];
+			for (int j = 0; j < RATIO_BLOCK_SIZE; j++) {
+				float diff = ratios[j] - x;
+				errors[j] += diff * diff;
 			}
 		}
-		if (error < bestMatchError) {
-			bestMatchError = error;
-			bestMatch = SYMBOL_TABLE[j];
+		for (int j = 0, count = std::min(RATIO_BLOCK_SIZE, SYMBOL_COUNT - begin); j < count; j++) {
+			if (errors[j] < bestMatchError || (errors[j] == bestMatchError && begin + j < bestMatch)) {
+				bestMatchError = errors[j];
+				bestMatch = begin + j;
+			}
 		}
-	}
-	return bestMatch;
+	};
+
+	const int first = narrow_cast<int>(std::min_element(bounds.begin(), bounds.end()) - bounds.begin());
+	searchBlock(first);
+	for (int b = 0; b < RATIO_BLOCK_COUNT; b++)
+		if (b != first)
+			searchBlock(b);
+
+	return SYMBOL_TABLE[bestMatch];
 }
 
 int
@@ -10,11 +10,11 @@
 #include "DecoderResult.h"
 #include "PDFDecoderResultExtra.h"
 #include "ZXAlgorithms.h"
-#include "ZXBigInteger.h"
 #include "ZXTestSupport.h"
 
 #include <array>
 #include <cassert>
+#include <cstdint>
 #include <sstream>
 #include <utility>
 
@@ -450,23 +450,33 @@ Remove leading 1 =>  Result is 000213298174000
 */
 static std::string DecodeBase900toBase10(const std::vector<int>& codewords, int endIndex, int count)
 {
-	// Table containing values for the exponent of 900.
-	static const auto EXP900 = []() {
-		std::array<BigInteger, 16> table = {1, 900};
-		for (size_t i = 2; i < table.size(); ++i)
-			table[i] = table[i - 1] * 900;
-		return table;
-	}();
+	// 900^16 < 10^48, so the value fits in 6 limbs of 9 decimal digits each (least significant first)
+	constexpr uint32_t BASE = 1000000000;
+	std::array<uint32_t, 6> limbs = {};
+	int numLimbs = 1;
 
 	assert(count <= 16);
 
-	BigInteger result;
-	for (int i = 0; i < count; i++)
-		result += EXP900[count - i - 1] * codewords[endIndex - count + i];
+	for (int i = endIndex - count; i < endIndex; i++) {
+		uint64_t carry = codewords[i];
+		for (int j = 0; j < numLimbs; j++) {
+			carry += uint64_t(limbs[j]) * 900;
+			limbs[j] = carry % BASE;
+			carry /= BASE;
+		}
+		if (carry)
+			limbs[numLimbs++] = narrow_cast<uint32_t>(carry);
+	}
+
+	// the most significant limb without leading zeros, all others with exactly 9 digits
+	std::array<char, 6 * 9> digits;
+	auto end = digits.end();
+	for (int j = 0; j < numLimbs; j++)
+		for (int k = 0; k < 9 && (j < numLimbs - 1 || k == 0 || limbs[j]); k++, limbs[j] /= 10)
+			*--end = narrow_cast<char>('0' + limbs[j] % 10);
 
-	std::string resultString = result.toString();
-	if (!resultString.empty() && resultString.front() == '1')
-		return resultString.substr(1);
+	if (*end == '1')
+		return std::string(end + 1, digits.end());
 
 	throw FormatError();
 }
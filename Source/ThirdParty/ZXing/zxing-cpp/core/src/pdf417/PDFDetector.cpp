@@ -14,7 +14,6 @@
 #include <array>
 #include <cstdlib>
 #include <limits>
-#include <list>
 #include <vector>
 
 namespace ZXing {
@@ -96,7 +95,7 @@ PatternMatchVariance(const std::vector<int>& counters, const std::vector<int>& p
 * @return start/end horizontal offset of guard pattern, as an array of two ints.
 */
 static bool
-FindGuardPattern(const BitMatrix& matrix, int column, int row, int width, bool whiteFirst, const std::vector<int>& pattern, std::vector<int>& counters, int& startPos, int& endPos)
+FindGuardPattern(const BitMatrixView& matrix, int column, int row, int width, bool whiteFirst, const std::vector<int>& pattern, std::vector<int>& counters, int& startPos, int& endPos)
 {
 	std::fill(counters.begin(), counters.end(), 0);
 	int patternLength = Size(pattern);
@@ -146,7 +145,7 @@ FindGuardPattern(const BitMatrix& matrix, int column, int row, int width, bool w
 }
 
 static std::array<Nullable<ResultPoint>, 4>&
-FindRowsWithPattern(const BitMatrix& matrix, int height, int width, int startRow, int startColumn, const std::vector<int>& pattern, std::array<Nullable<ResultPoint>, 4>& result)
+FindRowsWithPattern(const BitMatrixView& matrix, int height, int width, int startRow, int startColumn, const std::vector<int>& pattern, std::array<Nullable<ResultPoint>, 4>& result)
 {
 	bool found = false;
 	int startPos, endPos;
@@ -224,7 +223,7 @@ CopyToResult(std::array<Nullable<ResultPoint>, 8>& result, const std::array<Null
 *           vertices[6] x, y top right codeword area
 *           vertices[7] x, y bottom right codeword area
 */
-static std::array<Nullable<ResultPoint>, 8> FindVertices(const BitMatrix& matrix, int startRow, int startColumn)
+static std::array<Nullable<ResultPoint>, 8> FindVertices(const BitMatrixView& matrix, int startRow, int startColumn)
 {
 	int width = matrix.width();
 	int height = matrix.height();
@@ -253,12 +252,12 @@ static std::array<Nullable<ResultPoint>, 8> FindVertices(const BitMatrix& matrix
 * @param bitMatrix bit matrix to detect barcodes in
 * @return List of ResultPoint arrays containing the coordinates of found barcodes
 */
-static std::list<std::array<Nullable<ResultPoint>, 8>> DetectBarcode(const BitMatrix& bitMatrix, bool multiple)
+static std::vector<std::array<Nullable<ResultPoint>, 8>> DetectBarcode(const BitMatrixView& bitMatrix, bool multiple)
 {
 	int row = 0;
 	int column = 0;
 	bool foundBarcodeInRow = false;
-	std::list<std::array<Nullable<ResultPoint>, 8>> barcodeCoordinates;
+	std::vector<std::array<Nullable<ResultPoint>, 8>> barcodeCoordinates;
 
 	while (row < bitMatrix.height()) {
 		auto vertices = FindVertices(bitMatrix, row, column);
@@ -332,9 +331,8 @@ bool HasStartPattern(const BitMatrix& m, bool rotate90)
 */
 Detector::Result Detector::Detect(const BinaryBitmap& image, bool multiple, bool tryRotate)
 {
-	// construct a 'dummy' shared pointer, just be able to pass it up the call chain in DetectorResult
 	// TODO: reimplement PDF Detector
-	auto binImg = std::shared_ptr<const BitMatrix>(image.getBitMatrix(), [](const BitMatrix*){});
+	auto binImg = image.getBitMatrix();
 	if (!binImg)
 		return {};
 
@@ -344,25 +342,14 @@ Detector::Result Detector::Detect(const BinaryBitmap& image, bool multiple, bool
 		if (!HasStartPattern(*binImg, rotate90))
 			continue;
 
-		result.rotation = 90 * rotate90;
-		if (rotate90) {
-			auto newBits = std::make_shared<BitMatrix>(binImg->copy());
-			newBits->rotate90();
-			binImg = newBits;
+		// the rotated orientations are only views of the binarized image, no copy
+		for (int rotation : {90 * rotate90, 90 * rotate90 + 180}) {
+			result.rotation = rotation;
+			result.bits = BitMatrixView(*binImg, rotation);
+			result.points = DetectBarcode(result.bits, multiple);
+			if (!result.points.empty())
+				return result;
 		}
-
-		result.points = DetectBarcode(*binImg, multiple);
-		result.bits = binImg;
-		if (result.points.empty()) {
-			auto newBits = std::make_shared<BitMatrix>(binImg->copy());
-			newBits->rotate180();
-			result.points = DetectBarcode(*newBits, multiple);
-			result.rotation += 180;
-			result.bits = newBits;
-		}
-
-		if (!result.points.empty())
-			return result;
 	}
 
 	return {};
@@ -5,37 +5,64 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "PDFModulusGF.h"
+
+#include "ZXAlgorithms.h"
+
+#include <array>
 #include <stdexcept>
 
 namespace ZXing {
 namespace Pdf417 {
 
-ModulusGF::ModulusGF(int modulus, int generator) :
-	_modulus(modulus),
-	_zero(*this, { 0 }),
-	_one(*this, { 1 })
+namespace {
+
+template <int MODULUS, int GENERATOR>
+struct ModulusGFTables
 {
 #ifdef ZX_REED_SOLOMON_USE_MORE_MEMORY_FOR_SPEED
-	_expTable.resize(modulus * 2, 0);
+	std::array<short, MODULUS * 2> exp = {};
 #else
-	_expTable.resize(modulus, 0);
+	std::array<short, MODULUS> exp = {};
 #endif
-	_logTable.resize(modulus, 0);
-	int x = 1;
-	for (int i = 0; i < modulus; i++) {
-		_expTable[i] = x;
-		x = (x * generator) % modulus;
-	}
+	std::array<short, MODULUS> log = {};
+
+	constexpr ModulusGFTables()
+	{
+		int x = 1;
+		for (int i = 0; i < MODULUS; i++) {
+			exp[i] = static_cast<short>(x);
+			x = (x * GENERATOR) % MODULUS;
+		}
 
 #ifdef ZX_REED_SOLOMON_USE_MORE_MEMORY_FOR_SPEED
-	for (int i = modulus - 1; i < modulus * 2; ++i)
-		_expTable[i] = _expTable[i - (modulus - 1)];
+		for (int i = MODULUS - 1; i < MODULUS * 2; ++i)
+			exp[i] = exp[i - (MODULUS - 1)];
 #endif
 
-	for (int i = 0; i < modulus - 1; i++) {
-		_logTable[_expTable[i]] = i;
+		for (int i = 0; i < MODULUS - 1; i++) {
+			log[exp[i]] = static_cast<short>(i);
+		}
+		// log[0] == 0 but this should never be used
 	}
-	// logTable[0] == 0 but this should never be used
+};
+
+constexpr ModulusGFTables<929, 3> PDF417_TABLES = {};
+
+} // namespace
+
+ModulusGF::ModulusGF(int modulus, const short* expTable, const short* logTable) :
+	_modulus(modulus),
+	_expTable(expTable),
+	_logTable(logTable),
+	_zero(*this, { 0 }),
+	_one(*this, { 1 })
+{
+}
+
+const ModulusGF& ModulusGF::PDF417()
+{
+	static const ModulusGF field(Size(PDF417_TABLES.log), PDF417_TABLES.exp.data(), PDF417_TABLES.log.data());
+	return field;
 }
 
 ModulusPoly
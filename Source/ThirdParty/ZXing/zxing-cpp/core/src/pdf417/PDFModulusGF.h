@@ -24,8 +24,8 @@ namespace Pdf417 {
 class ModulusGF
 {
 	int _modulus;
-	std::vector<short> _expTable;
-	std::vector<short> _logTable;
+	const short* _expTable;
+	const short* _logTable;
 	ModulusPoly _zero;
 	ModulusPoly _one;
 
@@ -33,8 +33,12 @@ class ModulusGF
 	// see also https://stackoverflow.com/a/33333636/2088798
 	static int fast_mod(int a, int d) { return a < d ? a : a - d; }
 
+	ModulusGF(int modulus, const short* expTable, const short* logTable);
+
 public:
-	ModulusGF(int modulus, int generator);
+	/// The field GF(929) with generator 3 used for the PDF417 error correction. Its exp and log tables are
+	/// generated at compile time.
+	static const ModulusGF& PDF417();
 
 	const ModulusPoly& zero() const {
 		return _zero;
@@ -55,7 +59,7 @@ public:
 	}
 
 	int exp(int a) const {
-		return _expTable.at(a);
+		return _expTable[a];
 	}
 
 	int log(int a) const {
@@ -71,9 +71,9 @@ static Results DoDecode(const BinaryBitmap& image, bool multiple, bool tryRotate
 
 	auto rotate = [res = detectorResult](PointI p) {
 		switch(res.rotation) {
-		case 90: return PointI(res.bits->height() - p.y - 1, p.x);
-		case 180: return PointI(res.bits->width() - p.x - 1, res.bits->height() - p.y - 1);
-		case 270: return PointI(p.y, res.bits->width() - p.x - 1);
+		case 90: return PointI(res.bits.height() - p.y - 1, p.x);
+		case 180: return PointI(res.bits.width() - p.x - 1, res.bits.height() - p.y - 1);
+		case 270: return PointI(p.y, res.bits.width() - p.x - 1);
 		}
 		return p;
 	};
@@ -81,7 +81,7 @@ static Results DoDecode(const BinaryBitmap& image, bool multiple, bool tryRotate
 	Results results;
 	for (const auto& points : detectorResult.points) {
 		DecoderResult decoderResult =
-			ScanningDecoder::Decode(*detectorResult.bits, points[4], points[5], points[6], points[7],
+			ScanningDecoder::Decode(detectorResult.bits, points[4], points[5], points[6], points[7],
 									GetMinCodewordWidth(points), GetMaxCodewordWidth(points));
 		if (decoderResult.isValid(returnErrors)) {
 			auto point = [&](int i) { return rotate(PointI(points[i].value())); };
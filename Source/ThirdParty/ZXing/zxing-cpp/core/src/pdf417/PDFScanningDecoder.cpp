@@ -6,10 +6,12 @@
 
 #include "PDFScanningDecoder.h"
 
-#include "BitMatrix.h"
+#include "DecodeStatsSink.h"
 #include "DecoderResult.h"
+#include "Matrix.h"
 #include "PDFBarcodeMetadata.h"
 #include "PDFBarcodeValue.h"
+#include "PDFBitMatrixView.h"
 #include "PDFCodewordDecoder.h"
 #include "PDFDetectionResult.h"
 #include "PDFDecoder.h"
@@ -28,7 +30,7 @@ static const int MAX_EC_CODEWORDS = 512;
 
 using ModuleBitCountType = std::array<int, CodewordDecoder::BARS_IN_MODULE>;
 
-static int AdjustCodewordStartColumn(const BitMatrix& image, int minColumn, int maxColumn, bool leftToRight, int codewordStartColumn, int imageRow)
+static int AdjustCodewordStartColumn(const BitMatrixView& image, int minColumn, int maxColumn, bool leftToRight, int codewordStartColumn, int imageRow)
 {
 	int correctedStartColumn = codewordStartColumn;
 	int increment = leftToRight ? -1 : 1;
@@ -47,7 +49,7 @@ static int AdjustCodewordStartColumn(const BitMatrix& image, int minColumn, int
 	return correctedStartColumn;
 }
 
-static bool GetModuleBitCount(const BitMatrix& image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, ModuleBitCountType& moduleBitCount)
+static bool GetModuleBitCount(const BitMatrixView& image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, ModuleBitCountType& moduleBitCount)
 {
 	int imageColumn = startColumn;
 	size_t moduleNumber = 0;
@@ -104,7 +106,7 @@ static int GetCodewordBucketNumber(int codeword)
 	return GetCodewordBucketNumber(GetBitCountForCodeword(codeword));
 }
 
-static Nullable<Codeword> DetectCodeword(const BitMatrix& image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, int minCodewordWidth, int maxCodewordWidth)
+static Nullable<Codeword> DetectCodeword(const BitMatrixView& image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, int minCodewordWidth, int maxCodewordWidth)
 {
 	startColumn = AdjustCodewordStartColumn(image, minColumn, maxColumn, leftToRight, startColumn, imageRow);
 	// we usually know fairly exact now how long a codeword is. We should provide minimum and maximum expected length
@@ -155,7 +157,7 @@ static Nullable<Codeword> DetectCodeword(const BitMatrix& image, int minColumn,
 	return nullptr;
 }
 
-static DetectionResultColumn GetRowIndicatorColumn(const BitMatrix& image, const BoundingBox& boundingBox, const ResultPoint& startPoint, bool leftToRight, int minCodewordWidth, int maxCodewordWidth)
+static DetectionResultColumn GetRowIndicatorColumn(const BitMatrixView& image, const BoundingBox& boundingBox, const ResultPoint& startPoint, bool leftToRight, int minCodewordWidth, int maxCodewordWidth)
 {
 	DetectionResultColumn rowIndicatorColumn(boundingBox, leftToRight ? DetectionResultColumn::RowIndicator::Left : DetectionResultColumn::RowIndicator::Right);
 	for (int i = 0; i < 2; i++) {
@@ -304,12 +306,13 @@ static int GetStartColumn(const DetectionResult& detectionResult, int barcodeCol
 	return leftToRight ? detectionResult.getBoundingBox().value().minX() : detectionResult.getBoundingBox().value().maxX();
 }
 
-static std::vector<std::vector<BarcodeValue>> CreateBarcodeMatrix(DetectionResult& detectionResult)
+// The values of all codewords in a single allocation, indexed by (column, row). Column 0 and the last column are the
+// row indicator columns.
+using BarcodeValueMatrix = Matrix<BarcodeValue>;
+
+static BarcodeValueMatrix CreateBarcodeMatrix(DetectionResult& detectionResult)
 {
-	std::vector<std::vector<BarcodeValue>> barcodeMatrix(detectionResult.barcodeRowCount());
-	for (auto& row : barcodeMatrix) {
-		row.resize(detectionResult.barcodeColumnCount() + 2);
-	}
+	BarcodeValueMatrix barcodeMatrix(detectionResult.barcodeColumnCount() + 2, detectionResult.barcodeRowCount());
 
 	int column = 0;
 	for (auto& resultColumn : detectionResult.allColumns()) {
@@ -318,11 +321,11 @@ static std::vector<std::vector<BarcodeValue>> CreateBarcodeMatrix(DetectionResul
 				if (codeword != nullptr) {
 					int rowNumber = codeword.value().rowNumber();
 					if (rowNumber >= 0) {
-						if (rowNumber >= Size(barcodeMatrix)) {
+						if (rowNumber >= barcodeMatrix.height()) {
 							// We have more rows than the barcode metadata allows for, ignore them.
 							continue;
 						}
-						barcodeMatrix[rowNumber][column].setValue(codeword.value().value());
+						barcodeMatrix(column, rowNumber).setValue(codeword.value().value());
 					}
 				}
 			}
@@ -337,20 +340,20 @@ static int GetNumberOfECCodeWords(int barcodeECLevel)
 	return 2 << barcodeECLevel;
 }
 
-static bool AdjustCodewordCount(const DetectionResult& detectionResult, std::vector<std::vector<BarcodeValue>>& barcodeMatrix)
+static bool AdjustCodewordCount(const DetectionResult& detectionResult, BarcodeValueMatrix& barcodeMatrix)
 {
-	auto numberOfCodewords = barcodeMatrix[0][1].value();
+	auto numberOfCodewords = barcodeMatrix(1, 0).value();
 	int calculatedNumberOfCodewords = detectionResult.barcodeColumnCount() * detectionResult.barcodeRowCount() - GetNumberOfECCodeWords(detectionResult.barcodeECLevel());
 	if (calculatedNumberOfCodewords < 1 || calculatedNumberOfCodewords > CodewordDecoder::MAX_CODEWORDS_IN_BARCODE)
 		calculatedNumberOfCodewords = 0;
 	if (numberOfCodewords.empty()) {
 		if (!calculatedNumberOfCodewords)
 			return false;
-		barcodeMatrix[0][1].setValue(calculatedNumberOfCodewords);
+		barcodeMatrix(1, 0).setValue(calculatedNumberOfCodewords);
 	}
 	else if (calculatedNumberOfCodewords && numberOfCodewords[0] != calculatedNumberOfCodewords) {
 		// The calculated one is more reliable as it is derived from the row indicator columns
-		barcodeMatrix[0][1].setValue(calculatedNumberOfCodewords);
+		barcodeMatrix(1, 0).setValue(calculatedNumberOfCodewords);
 	}
 	return true;
 }
@@ -358,11 +361,10 @@ static bool AdjustCodewordCount(const DetectionResult& detectionResult, std::vec
 
 static const ModulusGF& GetModulusGF()
 {
-	static const ModulusGF field(CodewordDecoder::NUMBER_OF_CODEWORDS, 3);
-	return field;
+	return ModulusGF::PDF417();
 }
 
-static bool RunEuclideanAlgorithm(ModulusPoly a, ModulusPoly b, int R, ModulusPoly& sigma, ModulusPoly& omega)
+static bool RunEuclideanAlgorithm(ModulusPoly a, ModulusPoly b, int R, int numErasures, ModulusPoly& sigma, ModulusPoly& omega)
 {
 	const ModulusGF& field = GetModulusGF();
 
@@ -376,8 +378,8 @@ static bool RunEuclideanAlgorithm(ModulusPoly a, ModulusPoly b, int R, ModulusPo
 	ModulusPoly tLast = field.zero();
 	ModulusPoly t = field.one();
 
-	// Run Euclidean algorithm until r's degree is less than R/2
-	while (r.degree() >= R / 2) {
+	// Run Euclidean algorithm until r's degree is less than (R + numErasures) / 2
+	while (r.degree() >= (R + numErasures) / 2) {
 		ModulusPoly rLastLast = rLast;
 		ModulusPoly tLastLast = tLast;
 		rLast = r;
@@ -451,13 +453,17 @@ static std::vector<int> FindErrorMagnitudes(const ModulusPoly& errorEvaluator, c
 }
 
 /**
+* Errors-and-erasures decoding: the known erasure positions are taken into account via the erasure locator
+* (see Forney's modified syndrome), so each erasure only costs one EC codeword instead of two. Up to
+* (numECCodewords - erasures.size()) / 2 additional errors at unknown positions can be corrected.
+*
 * @param received received codewords
 * @param numECCodewords number of those codewords used for EC
 * @param erasures location of erasures
 * @return false if errors cannot be corrected, maybe because of too many errors
 */
 ZXING_EXPORT_TEST_ONLY
-bool DecodeErrorCorrection(std::vector<int>& received, int numECCodewords, const std::vector<int>& erasures [[maybe_unused]], int& nbErrors)
+bool DecodeErrorCorrection(std::vector<int>& received, int numECCodewords, const std::vector<int>& erasures, int& nbErrors)
 {
 	const ModulusGF& field = GetModulusGF();
 	ModulusPoly poly(field, received);
@@ -476,23 +482,36 @@ bool DecodeErrorCorrection(std::vector<int>& received, int numECCodewords, const
 		return true;
 	}
 
-//	ModulusPoly knownErrors = field.one();
-//	for (int erasure : erasures) {
-//		int b = field.exp(Size(received) - 1 - erasure);
-//		// Add (1 - bx) term:
-//		ModulusPoly term(field, { field.subtract(0, b), 1 });
-//		knownErrors = knownErrors.multiply(term);
-//	}
+	int receivedSize = Size(received);
+	if (Size(erasures) > numECCodewords)
+		return false;
+
+	ModulusPoly knownErrors = field.one();
+	for (int erasure : erasures) {
+		if (erasure < 0 || erasure >= receivedSize)
+			return false;
+		int b = field.exp(receivedSize - 1 - erasure);
+		// Add (1 - bx) term:
+		ModulusPoly term(field, { field.subtract(0, b), 1 });
+		knownErrors = knownErrors.multiply(term);
+	}
 
 	ModulusPoly syndrome(field, S);
-//	syndrome = syndrome.multiply(knownErrors);
+	if (!erasures.empty()) {
+		// modified syndrome: syndrome * knownErrors mod x^numECCodewords
+		auto product = syndrome.multiply(knownErrors);
+		for (int i = 0; i < numECCodewords; ++i)
+			S[numECCodewords - 1 - i] = product.coefficient(i);
+		syndrome = ModulusPoly(field, S);
+	}
 
 	ModulusPoly sigma, omega;
-	if (!RunEuclideanAlgorithm(field.buildMonomial(numECCodewords, 1), syndrome, numECCodewords, sigma, omega)) {
+	if (!RunEuclideanAlgorithm(field.buildMonomial(numECCodewords, 1), syndrome, numECCodewords, Size(erasures), sigma, omega)) {
 		return false;
 	}
 
-//	sigma = sigma.multiply(knownErrors);
+	// the complete error locator includes the erasures
+	sigma = sigma.multiply(knownErrors);
 
 	std::vector<int> errorLocations;
 	if (!FindErrorLocations(sigma, errorLocations)) {
@@ -501,7 +520,6 @@ bool DecodeErrorCorrection(std::vector<int>& received, int numECCodewords, const
 
 	std::vector<int> errorMagnitudes = FindErrorMagnitudes(omega, sigma, errorLocations);
 
-	int receivedSize = Size(received);
 	for (size_t i = 0; i < errorLocations.size(); i++) {
 		int position = receivedSize - 1 - field.log(errorLocations[i]);
 		if (position < 0) {
@@ -532,7 +550,9 @@ static bool CorrectErrors(std::vector<int>& codewords, const std::vector<int>& e
 		// Too many errors or EC Codewords is corrupted
 		return false;
 	}
-	return DecodeErrorCorrection(codewords, numECCodewords, erasures, errorCount);
+	bool success = DecodeErrorCorrection(codewords, numECCodewords, erasures, errorCount);
+	ZX_STATS_COUNT(ReedSolomonFailures, !success);
+	return success;
 }
 
 /**
@@ -587,18 +607,16 @@ DecoderResult DecodeCodewords(std::vector<int>& codewords, int numECCodeWords)
 	for (auto& cw : codewords)
 		cw = std::clamp(cw, 0, CodewordDecoder::MAX_CODEWORDS_IN_BARCODE);
 
-	// erasures array has never been actually used inside the error correction code
 	return DecodeCodewords(codewords, numECCodeWords, {});
 }
 
 
 /**
 * This method deals with the fact, that the decoding process doesn't always yield a single most likely value. The
-* current error correction implementation doesn't deal with erasures very well, so it's better to provide a value
-* for these ambiguous codewords instead of treating it as an erasure. The problem is that we don't know which of
-* the ambiguous values to choose. We try decode using the first value, and if that fails, we use another of the
-* ambiguous values and try to decode again. This usually only happens on very hard to read and decode barcodes,
-* so decoding the normal barcodes is not affected by this.
+* problem is that we don't know which of the ambiguous values to choose. We try decode using the first value, and if
+* that fails, we treat all ambiguous codewords as erasures (which costs only one EC codeword each, half of what an
+* error costs). If that fails as well, we use another of the ambiguous values and try to decode again. This usually
+* only happens on very hard to read and decode barcodes, so decoding the normal barcodes is not affected by this.
 *
 * @param erasureArray contains the indexes of erasures
 * @param ambiguousIndexes array with the indexes that have more than one most likely value
@@ -624,6 +642,19 @@ static DecoderResult CreateDecoderResultFromAmbiguousValues(int ecLevel, std::ve
 		if (ambiguousIndexCount.empty()) {
 			return ChecksumError();
 		}
+
+		if (tries == 99) {
+			// DecodeCodewords corrects in place, so work on a copy to keep the retry loop below unaffected
+			auto copy = codewords;
+			auto erasures = erasureArray;
+			erasures.insert(erasures.end(), ambiguousIndexes.begin(), ambiguousIndexes.end());
+			result = DecodeCodewords(copy, NumECCodeWords(ecLevel), erasures);
+			if (result.error() != Error::Checksum) {
+				codewords = std::move(copy);
+				return result;
+			}
+		}
+
 		for (size_t i = 0; i < ambiguousIndexCount.size(); i++) {
 			if (ambiguousIndexCount[i] < Size(ambiguousIndexValues[i]) - 1) {
 				ambiguousIndexCount[i]++;
@@ -653,17 +684,17 @@ static DecoderResult CreateDecoderResult(DetectionResult& detectionResult)
 	std::vector<int> ambiguousIndexesList;
 	for (int row = 0; row < detectionResult.barcodeRowCount(); row++) {
 		for (int column = 0; column < detectionResult.barcodeColumnCount(); column++) {
-			auto values = barcodeMatrix[row][column + 1].value();
+			auto& cell = barcodeMatrix(column + 1, row);
 			int codewordIndex = row * detectionResult.barcodeColumnCount() + column;
-			if (values.empty()) {
+			if (cell.empty()) {
 				erasures.push_back(codewordIndex);
 			}
-			else if (values.size() == 1) {
-				codewords[codewordIndex] = values[0];
+			else if (int value = cell.uniqueValue(); value != -1) {
+				codewords[codewordIndex] = value;
 			}
 			else {
 				ambiguousIndexesList.push_back(codewordIndex);
-				ambiguousIndexValues.push_back(values);
+				ambiguousIndexValues.push_back(cell.value());
 			}
 		}
 	}
@@ -677,10 +708,12 @@ static DecoderResult CreateDecoderResult(DetectionResult& detectionResult)
 // This approach also allows detecting more details about the barcode, e.g. if a bar type (white or black) is wider 
 // than it should be. This can happen if the scanner used a bad blackpoint.
 DecoderResult
-ScanningDecoder::Decode(const BitMatrix& image, const Nullable<ResultPoint>& imageTopLeft, const Nullable<ResultPoint>& imageBottomLeft,
+ScanningDecoder::Decode(const BitMatrixView& image, const Nullable<ResultPoint>& imageTopLeft, const Nullable<ResultPoint>& imageBottomLeft,
 	const Nullable<ResultPoint>& imageTopRight, const Nullable<ResultPoint>& imageBottomRight,
 	int minCodewordWidth, int maxCodewordWidth)
 {
+	ZX_STATS_TIMER(Decoding);
+
 	BoundingBox boundingBox;
 	if (!BoundingBox::Create(image.width(), image.height(), imageTopLeft, imageBottomLeft, imageTopRight, imageBottomRight, boundingBox)) {
 		return {};
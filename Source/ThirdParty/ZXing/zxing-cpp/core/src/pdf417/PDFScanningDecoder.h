@@ -10,20 +10,21 @@
 
 namespace ZXing {
 
-class BitMatrix;
 class ResultPoint;
 class DecoderResult;
 template <typename T> class Nullable;
 
 namespace Pdf417 {
 
+class BitMatrixView;
+
 /**
 * @author Guenther Grau
 */
 class ScanningDecoder
 {
 public:
-	static DecoderResult Decode(const BitMatrix& image,
+	static DecoderResult Decode(const BitMatrixView& image,
 		const Nullable<ResultPoint>& imageTopLeft, const Nullable<ResultPoint>& imageBottomLeft,
 		const Nullable<ResultPoint>& imageTopRight, const Nullable<ResultPoint>& imageBottomRight,
 		int minCodewordWidth, int maxCodewordWidth);
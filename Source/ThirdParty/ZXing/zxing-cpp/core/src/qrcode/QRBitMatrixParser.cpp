@@ -13,7 +13,12 @@
 #include "QRFormatInformation.h"
 #include "QRVersion.h"
 
-#include <utility>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
 
 namespace ZXing::QRCode {
 
@@ -96,84 +101,119 @@ FormatInformation ReadFormatInformation(const BitMatrix& bitMatrix, bool isMicro
 	return FormatInformation::DecodeQR(formatInfoBits1, formatInfoBits2);
 }
 
-static ByteArray ReadQRCodewords(const BitMatrix& bitMatrix, const Version& version, const FormatInformation& formatInfo)
+namespace {
+
+// The data modules of a symbol version in the order they are read (see ISO 18004:2006 6.7.3) together with the
+// data mask bits at those positions. Building this once per version turns the codeword extraction into a table
+// lookup per module and the unmasking into a XOR of 64 modules at a time.
+struct CodewordLayout
 {
-	BitMatrix functionPattern = version.buildFunctionPattern();
+	std::array<std::vector<uint16_t>, 2> modules; // module index (y * dimension + x), [1] for mirrored symbols
+	std::array<std::vector<uint64_t>, 8> masks;   // mask bits in reading order, msb first, 4 masks for micro QR
+};
 
-	ByteArray result;
-	result.reserve(version.totalCodewords());
-	uint8_t currentByte = 0;
+} // namespace
+
+static CodewordLayout BuildCodewordLayout(const Version& version)
+{
+	const BitMatrix functionPattern = version.buildFunctionPattern();
+	const bool isMicro = version.isMicroQRCode();
+	const int dimension = version.dimension();
+
+	CodewordLayout layout;
 	bool readingUp = true;
-	int bitsRead = 0;
-	int dimension = bitMatrix.height();
 	// Read columns in pairs, from right to left
 	for (int x = dimension - 1; x > 0; x -= 2) {
 		// Skip whole column with vertical timing pattern.
-		if (x == 6)
+		if (x == 6 && !isMicro)
 			x--;
 		// Read alternatingly from bottom to top then top to bottom
 		for (int row = 0; row < dimension; row++) {
 			int y = readingUp ? dimension - 1 - row : row;
-			for (int col = 0; col < 2; col++) {
-				int xx = x - col;
+			for (int xx : {x, x - 1}) {
 				// Ignore bits covered by the function pattern
 				if (!functionPattern.get(xx, y)) {
-					// Read a bit
-					AppendBit(currentByte,
-							  GetDataMaskBit(formatInfo.dataMask, xx, y) != getBit(bitMatrix, xx, y, formatInfo.isMirrored));
-					// If we've made a whole byte, save it off
-					if (++bitsRead % 8 == 0)
-						result.push_back(std::exchange(currentByte, 0));
+					layout.modules[0].push_back(narrow_cast<uint16_t>(y * dimension + xx));
+					layout.modules[1].push_back(narrow_cast<uint16_t>(xx * dimension + y));
 				}
 			}
 		}
 		readingUp = !readingUp; // switch directions
 	}
-	if (Size(result) != version.totalCodewords())
-		return {};
 
-	return result;
+	const int numModules = Size(layout.modules[0]);
+	for (int mask = 0; mask < (isMicro ? 4 : 8); ++mask) {
+		layout.masks[mask].resize((numModules + 63) / 64);
+		for (int i = 0; i < numModules; ++i) {
+			int x = layout.modules[0][i] % dimension, y = layout.modules[0][i] / dimension;
+			if (GetDataMaskBit(mask, x, y, isMicro))
+				layout.masks[mask][i / 64] |= uint64_t(1) << (63 - i % 64);
+		}
+	}
+
+	return layout;
+}
+
+static const CodewordLayout& GetCodewordLayout(const Version& version)
+{
+	constexpr int NumVersions = 40 + 4;
+	static std::array<std::once_flag, NumVersions> once;
+	static std::array<CodewordLayout, NumVersions> layouts;
+
+	const int index = version.versionNumber() - 1 + (version.isMicroQRCode() ? 40 : 0);
+	std::call_once(once[index], [&] { layouts[index] = BuildCodewordLayout(version); });
+	return layouts[index];
 }
 
-static ByteArray ReadMQRCodewords(const BitMatrix& bitMatrix, const QRCode::Version& version, const FormatInformation& formatInfo)
+ByteArray ReadCodewords(const BitMatrix& bitMatrix, const Version& version, const FormatInformation& formatInfo)
 {
-	BitMatrix functionPattern = version.buildFunctionPattern();
+	const bool isMicro = version.isMicroQRCode();
+	if (!hasValidDimension(bitMatrix, isMicro) || bitMatrix.width() != bitMatrix.height())
+		return {};
+	if (formatInfo.dataMask >= (isMicro ? 4 : 8))
+		throw std::invalid_argument("QRCode maskIndex out of range");
+
+	const auto& layout = GetCodewordLayout(version);
+	const auto& modules = layout.modules[formatInfo.isMirrored];
+	const auto& mask = layout.masks[formatInfo.dataMask];
+	const int numModules = Size(modules);
+	const auto* data = bitMatrix.row(0).begin();
+
+	// gather the data modules in reading order and unmask them 64 at a time
+	std::vector<uint64_t> bits(mask.size());
+	for (int w = 0, i = 0; w < Size(bits); ++w) {
+		uint64_t word = 0;
+		for (int end = std::min(i + 64, numModules); i < end; ++i)
+			word = (word << 1) | (data[modules[i]] & 1);
+		if (numModules % 64 && w == Size(bits) - 1)
+			word <<= 64 - numModules % 64;
+		bits[w] = word ^ mask[w];
+	}
+
+	// read len <= 8 bits starting at offset
+	auto readBits = [&bits](int offset, int len) {
+		uint64_t v = bits[offset / 64] << (offset % 64);
+		if (offset % 64 + len > 64)
+			v |= bits[offset / 64 + 1] >> (64 - offset % 64);
+		return narrow_cast<uint8_t>(v >> (64 - len));
+	};
 
 	// D3 in a Version M1 symbol, D11 in a Version M3-L symbol and D9
 	// in a Version M3-M symbol is a 2x2 square 4-module block.
 	// See ISO 18004:2006 6.7.3.
-	bool hasD4mBlock = version.versionNumber() % 2 == 1;
-	int d4mBlockIndex =
-		version.versionNumber() == 1 ? 3 : (formatInfo.ecLevel == QRCode::ErrorCorrectionLevel::Low ? 11 : 9);
+	int d4mBlockIndex = -1;
+	if (isMicro && version.versionNumber() % 2 == 1)
+		d4mBlockIndex = version.versionNumber() == 1 ? 3 : (formatInfo.ecLevel == ErrorCorrectionLevel::Low ? 11 : 9);
 
 	ByteArray result;
 	result.reserve(version.totalCodewords());
-	uint8_t currentByte = 0;
-	bool readingUp = true;
-	int bitsRead = 0;
-	int dimension = bitMatrix.height();
-	// Read columns in pairs, from right to left
-	for (int x = dimension - 1; x > 0; x -= 2) {
-		// Read alternatingly from bottom to top then top to bottom
-		for (int row = 0; row < dimension; row++) {
-			int y = readingUp ? dimension - 1 - row : row;
-			for (int col = 0; col < 2; col++) {
-				int xx = x - col;
-				// Ignore bits covered by the function pattern
-				if (!functionPattern.get(xx, y)) {
-					// Read a bit
-					AppendBit(currentByte,
-							  GetDataMaskBit(formatInfo.dataMask, xx, y, true) != getBit(bitMatrix, xx, y, formatInfo.isMirrored));
-					++bitsRead;
-					// If we've made a whole byte, save it off; save early if 2x2 data block.
-					if (bitsRead == 8 || (bitsRead == 4 && hasD4mBlock && Size(result) == d4mBlockIndex - 1)) {
-						result.push_back(std::exchange(currentByte, 0));
-						bitsRead = 0;
-					}
-				}
-			}
-		}
-		readingUp = !readingUp; // switch directions
+	for (int offset = 0;;) {
+		// the codeword is cut short after 4 bits if it is the 2x2 data block
+		int len = Size(result) == d4mBlockIndex - 1 ? 4 : 8;
+		if (offset + len > numModules)
+			break;
+		result.push_back(readBits(offset, len));
+		offset += len;
 	}
 	if (Size(result) != version.totalCodewords())
 		return {};
@@ -181,13 +221,4 @@ static ByteArray ReadMQRCodewords(const BitMatrix& bitMatrix, const QRCode::Vers
 	return result;
 }
 
-ByteArray ReadCodewords(const BitMatrix& bitMatrix, const Version& version, const FormatInformation& formatInfo)
-{
-	if (!hasValidDimension(bitMatrix, version.isMicroQRCode()))
-		return {};
-
-	return version.isMicroQRCode() ? ReadMQRCodewords(bitMatrix, version, formatInfo)
-								   : ReadQRCodewords(bitMatrix, version, formatInfo);
-}
-
 } // namespace ZXing::QRCode
@@ -9,6 +9,7 @@
 #include "BitMatrix.h"
 #include "BitSource.h"
 #include "CharacterSet.h"
+#include "DecodeStatsSink.h"
 #include "DecoderResult.h"
 #include "GenericGF.h"
 #include "QRBitMatrixParser.h"
@@ -316,6 +317,8 @@ DecoderResult DecodeBitStream(ByteArray&& bytes, const Version& version, ErrorCo
 
 DecoderResult Decode(const BitMatrix& bits)
 {
+	ZX_STATS_TIMER(Decoding);
+
 	const Version* pversion = ReadVersion(bits);
 	if (!pversion)
 		return FormatError("Invalid version");
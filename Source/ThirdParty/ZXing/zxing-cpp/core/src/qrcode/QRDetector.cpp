@@ -13,6 +13,7 @@
 #include "ConcentricFinder.h"
 #include "GridSampler.h"
 #include "LogMatrix.h"
+#include "Parallel.h"
 #include "Pattern.h"
 #include "QRFormatInformation.h"
 #include "QRVersion.h"
@@ -24,6 +25,8 @@
 #include <cstdlib>
 #include <iterator>
 #include <map>
+#include <numeric>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -48,37 +51,39 @@ PatternView FindPattern(const PatternView& view)
 	});
 }
 
-std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool tryHarder)
+// a potential finder pattern center found on a scan line, see ScanFinderPatternRows
+struct FinderPatternHit
 {
-	constexpr int MIN_SKIP         = 3;           // 1 pixel/module times 3 modules/center
-	constexpr int MAX_MODULES_FAST = 20 * 4 + 17; // support up to version 20 for mobile clients
-
-	// Let's assume that the maximum version QR Code we support takes up 1/4 the height of the
-	// image, and then account for the center being 3 modules in size. This gives the smallest
-	// number of pixels the center could be, so skip this often. When trying harder, look for all
-	// QR versions regardless of how dense they are.
-	int height = image.height();
-	int skip = (3 * height) / (4 * MAX_MODULES_FAST);
-	if (skip < MIN_SKIP || tryHarder)
-		skip = MIN_SKIP;
+	PointF p;
+	int range;
+	std::optional<ConcentricPattern> pattern;
+	bool located; // false if the hit was skipped because it is inside an earlier pattern of the same band
+};
 
-	std::vector<ConcentricPattern> res;
+/**
+ * Scan every skip'th row in [yBegin, yEnd) for finder patterns. Hits inside an already found pattern of this band
+ * are not located. If hits is not nullptr, all hits get recorded so the result can be merged with other bands later.
+ */
+static FinderPatterns ScanFinderPatternRows(const BitMatrix& image, int yBegin, int yEnd, int skip,
+											std::vector<FinderPatternHit>* hits)
+{
+	FinderPatterns res;
 	[[maybe_unused]] int N = 0;
 	PatternRow row;
 
-	for (int y = skip - 1; y < height; y += skip) {
+	for (int y = yBegin; y < yEnd; y += skip) {
 		GetPatternRow(image, y, row, false);
 		PatternView next = row;
 
 		while (next = FindPattern(next), next.isValid()) {
 			PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] / 2.0, y + 0.5);
+			int range = Reduce(next) * 3; // 3 for very skewed samples
 
 			// make sure p is not 'inside' an already found pattern area
 			if (FindIf(res, [p](const auto& old) { return distance(p, old) < old.size / 2; }) == res.end()) {
 				log(p);
 				N++;
-				auto pattern = LocateConcentricPattern<E2E>(image, PATTERN, p,
-															Reduce(next) * 3); // 3 for very skewed samples
+				auto pattern = LocateConcentricPattern<E2E>(image, PATTERN, p, range);
 				if (pattern) {
 					log(*pattern, 3);
 					log(*pattern + PointF(.2, 0), 3);
@@ -88,6 +93,10 @@ std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool t
 					assert(image.get(pattern->x, pattern->y));
 					res.push_back(*pattern);
 				}
+				if (hits)
+					hits->push_back({p, range, pattern, true});
+			} else if (hits) {
+				hits->push_back({p, range, std::nullopt, false});
 			}
 
 			next.skipPair();
@@ -101,6 +110,51 @@ std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool t
 	return res;
 }
 
+FinderPatterns FindFinderPatterns(const BitMatrix& image, bool tryHarder, int numThreads)
+{
+	constexpr int MIN_SKIP         = 3;           // 1 pixel/module times 3 modules/center
+	constexpr int MAX_MODULES_FAST = 20 * 4 + 17; // support up to version 20 for mobile clients
+
+	// Let's assume that the maximum version QR Code we support takes up 1/4 the height of the
+	// image, and then account for the center being 3 modules in size. This gives the smallest
+	// number of pixels the center could be, so skip this often. When trying harder, look for all
+	// QR versions regardless of how dense they are.
+	int height = image.height();
+	int skip = (3 * height) / (4 * MAX_MODULES_FAST);
+	if (skip < MIN_SKIP || tryHarder)
+		skip = MIN_SKIP;
+
+	// every band should have enough rows to make up for the overhead of the thread
+	constexpr int MIN_ROWS_PER_BAND = 64;
+	const int numRows = height / skip;
+	const int numBands = numThreads == 1 ? 1 : NumWorkerThreads(numThreads, numRows / MIN_ROWS_PER_BAND);
+	if (numBands == 1)
+		return ScanFinderPatternRows(image, skip - 1, height, skip, nullptr);
+
+	// Scan the bands concurrently, each band only knows about its own patterns. Then replay all hits in row order
+	// against the merged list to reproduce the result of the single band scan: a hit is dropped if it is inside an
+	// earlier pattern, otherwise it gets located (usually that has already been done by the band).
+	std::vector<std::vector<FinderPatternHit>> hits(numBands);
+	ParallelFor(numBands, numThreads, [&](int band, int) {
+		int yBegin = skip - 1 + numRows * band / numBands * skip;
+		int yEnd = skip - 1 + numRows * (band + 1) / numBands * skip;
+		ScanFinderPatternRows(image, yBegin, std::min(yEnd, height), skip, &hits[band]);
+	});
+
+	FinderPatterns res;
+	for (auto& bandHits : hits)
+		for (auto& hit : bandHits) {
+			if (FindIf(res, [p = hit.p](const auto& old) { return distance(p, old) < old.size / 2; }) != res.end())
+				continue;
+			if (!hit.located)
+				hit.pattern = LocateConcentricPattern<E2E>(image, PATTERN, hit.p, hit.range);
+			if (hit.pattern)
+				res.push_back(*hit.pattern);
+		}
+
+	return res;
+}
+
 /**
  * @brief GenerateFinderPatternSets
  * @param patterns list of ConcentricPattern objects, i.e. found finder pattern squares
@@ -121,17 +175,44 @@ FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns)
 	const double cosUpper = std::cos(45. / 180 * 3.1415); // TODO: use c++20 std::numbers::pi_v
 	const double cosLower = std::cos(135. / 180 * 3.1415);
 
+	// Only a small subset of all triples can pass the tests below, so instead of enumerating all of them, collect the
+	// candidates for j and k per i from a spatial index (patterns sorted by x) and a module size range. The triples
+	// are still visited in the original (i, j, k) order, so the resulting sets (including the order of equally
+	// plausible ones) do not change. The pruning only relies on necessary conditions of the tests below:
+	// * the pattern sizes are too different to be part of the same symbol if c->size > a->size * 2
+	// * the moduleCount limit means distAB + distBC <= (177 * 1.5 - 7) * 2 * (a->size + b->size + c->size) / 21
+	// * the angle limit (cosAB_BC >= cosLower) implies distAC <= distAB + distBC
+	// * the squaredDistance is never shorter than the euclidean one (the size ratio is >= 1, the list is sorted)
+	// So all three euclidean distances in a valid triple are bounded by the moduleCount limit with sizes <= 2 * a->size.
 	int nbPatterns = Size(patterns);
+	std::vector<int> byX(nbPatterns);
+	std::iota(byX.begin(), byX.end(), 0);
+	std::sort(byX.begin(), byX.end(), [&patterns](int l, int r) { return patterns[l].x < patterns[r].x; });
+	std::vector<double> xs(nbPatterns);
+	for (int i = 0; i < nbPatterns; ++i)
+		xs[i] = patterns[byX[i]].x;
+
+	std::vector<int> candidates;
 	for (int i = 0; i < nbPatterns - 2; i++) {
-		for (int j = i + 1; j < nbPatterns - 1; j++) {
-			for (int k = j + 1; k < nbPatterns - 0; k++) {
+		const auto& pi = patterns[i];
+		const int end = narrow_cast<int>(std::upper_bound(patterns.begin() + i, patterns.end(), pi.size * 2,
+														  [](int size, const auto& p) { return size < p.size; })
+										  - patterns.begin());
+		const double maxDist = 1.01 * (177 * 1.5 - 7) * 2 * (5 * pi.size) / 21; // 1% margin for rounding errors
+
+		candidates.clear();
+		for (auto it = std::lower_bound(xs.begin(), xs.end(), pi.x - maxDist); it != xs.end() && *it <= pi.x + maxDist; ++it)
+			if (int m = byX[it - xs.begin()]; i < m && m < end && distance(pi, patterns[m]) <= maxDist)
+				candidates.push_back(m);
+		std::sort(candidates.begin(), candidates.end());
+
+		for (int jj = 0; jj < Size(candidates) - 1; jj++) {
+			for (int kk = jj + 1; kk < Size(candidates); kk++) {
 				const auto* a = &patterns[i];
-				const auto* b = &patterns[j];
-				const auto* c = &patterns[k];
-				// if the pattern sizes are too different to be part of the same symbol, skip this
-				// and the rest of the innermost loop (sorted list)
-				if (c->size > a->size * 2)
-					break;
+				const auto* b = &patterns[candidates[jj]];
+				const auto* c = &patterns[candidates[kk]];
+				if (distance(*b, *c) > maxDist)
+					continue;
 
 				// Orders the three points in an order [A,B,C] such that AB is less than AC
 				// and BC is less than AC, and the angle between BC and BA is less than 180 degrees.
@@ -404,7 +485,7 @@ DetectorResult SampleQR(const BitMatrix& image, const FinderPatternSet& fp)
 			mod2Pix = Mod2Pix(dimension, brOffset, {fp.tl, fp.tr, br, fp.bl});
 		}
 #if 1
-		auto& apM = version->alignmentPatternCenters(); // alignment pattern positions in modules
+		auto apM = version->alignmentPatternCenters(); // alignment pattern positions in modules
 		auto apP = Matrix<std::optional<PointF>>(Size(apM), Size(apM)); // found/guessed alignment pattern positions in pixels
 		const int N = Size(apM) - 1;
 
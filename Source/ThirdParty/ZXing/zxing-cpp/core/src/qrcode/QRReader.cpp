@@ -10,6 +10,7 @@
 #include "BinaryBitmap.h"
 #include "ConcentricFinder.h"
 #include "DecodeHints.h"
+#include "DecodeStatsSink.h"
 #include "DecoderResult.h"
 #include "DetectorResult.h"
 #include "LogMatrix.h"
@@ -74,7 +75,8 @@ Results Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 	LogMatrixWriter lmw(log, *binImg, 5, "qr-log.pnm");
 #endif
 
-	auto allFPs = FindFinderPatterns(*binImg, _hints.tryHarder());
+	auto allFPs = FindFinderPatterns(*binImg, _hints.tryHarder(), _hints.maxNumberOfThreads());
+	ZX_STATS_COUNT(FinderPatternCandidates, Size(allFPs));
 
 #ifdef PRINT_DEBUG
 	printf("allFPs: %d\n", Size(allFPs));
@@ -90,6 +92,7 @@ Results Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 				continue;
 
 			logFPSet(fpSet);
+			ZX_STATS_COUNT(FinderPatternSetsSampled, 1);
 
 			auto detectorResult = SampleQR(*binImg, fpSet);
 			if (detectorResult.isValid()) {
@@ -18,7 +18,7 @@ namespace ZXing::QRCode {
 	* See ISO 18004:2006 Annex D.
 	* Element i represents the raw version bits that specify version i + 7
 	*/
-	static const int VERSION_DECODE_INFO[] = {
+	static constexpr int VERSION_DECODE_INFO[] = {
 		0x07C94, 0x085BC, 0x09A99, 0x0A4D3, 0x0BBF6,
 		0x0C762, 0x0D847, 0x0E60D, 0x0F928, 0x10B78,
 		0x1145D, 0x12A17, 0x13532, 0x149A6, 0x15683,
@@ -34,7 +34,7 @@ Version::AllVersions()
 	/**
 	* See ISO 18004:2006 6.5.1 Table 9
 	*/
-	static const Version allVersions[] = {
+	static constexpr Version allVersions[] = {
 		{1, {}, {
 			7,  1, 19, 0, 0,
 			10, 1, 16, 0, 0,
@@ -284,7 +284,7 @@ const Version* Version::AllMicroVersions()
 	/**
 	 * See ISO 18004:2006 6.5.1 Table 9
 	 */
-	static const Version allVersions[] = {
+	static constexpr Version allVersions[] = {
 		{1, {2, 1, 3, 0, 0}},
 		{2, {5, 1, 5, 0, 0, 6, 1, 4, 0, 0}},
 		{3, {6, 1, 11, 0, 0, 8, 1, 9, 0, 0}},
@@ -292,18 +292,6 @@ const Version* Version::AllMicroVersions()
 	return allVersions;
 }
 
-Version::Version(int versionNumber, std::initializer_list<int> alignmentPatternCenters, const std::array<ECBlocks, 4>& ecBlocks)
-	: _versionNumber(versionNumber), _alignmentPatternCenters(alignmentPatternCenters), _ecBlocks(ecBlocks), _isMicro(false)
-{
-	_totalCodewords = ecBlocks[0].totalDataCodewords();
-}
-
-Version::Version(int versionNumber, const std::array<ECBlocks, 4>& ecBlocks)
-	: _versionNumber(versionNumber), _ecBlocks(ecBlocks), _isMicro(true)
-{
-	_totalCodewords = ecBlocks[0].totalDataCodewords();
-}
-
 const Version* Version::FromNumber(int versionNumber, bool isMicro)
 {
 	if (versionNumber < 1 || versionNumber > (isMicro ? 4 : 40)) {
@@ -371,7 +359,7 @@ BitMatrix Version::buildFunctionPattern() const
 		bitMatrix.setRegion(0, dimension - 8, 9, 8);
 
 		// Alignment patterns
-		size_t max = _alignmentPatternCenters.size();
+		size_t max = _numAlignmentPatternCenters;
 		for (size_t x = 0; x < max; ++x) {
 			int i = _alignmentPatternCenters[x] - 2;
 			for (size_t y = 0; y < max; ++y) {
@@ -8,10 +8,10 @@
 
 #include "QRECB.h"
 #include "QRErrorCorrectionLevel.h"
+#include "Range.h"
 
 #include <array>
 #include <initializer_list>
-#include <vector>
 
 namespace ZXing {
 
@@ -29,7 +29,10 @@ class Version
 public:
 	int versionNumber() const { return _versionNumber; }
 
-	const std::vector<int>& alignmentPatternCenters() const { return _alignmentPatternCenters; }
+	Range<const int*> alignmentPatternCenters() const
+	{
+		return {_alignmentPatternCenters.data(), _alignmentPatternCenters.data() + _numAlignmentPatternCenters};
+	}
 
 	int totalCodewords() const { return _totalCodewords; }
 
@@ -62,13 +65,27 @@ public:
 
 private:
 	int _versionNumber;
-	std::vector<int> _alignmentPatternCenters;
+	std::array<int, 7> _alignmentPatternCenters = {};
+	int _numAlignmentPatternCenters = 0;
 	std::array<ECBlocks, 4> _ecBlocks;
 	int _totalCodewords;
 	bool _isMicro;
 
-	Version(int versionNumber, std::initializer_list<int> alignmentPatternCenters, const std::array<ECBlocks, 4> &ecBlocks);
-	Version(int versionNumber, const std::array<ECBlocks, 4>& ecBlocks);
+	// constexpr so the version tables are constant initialized
+	constexpr Version(int versionNumber, std::initializer_list<int> alignmentPatternCenters, const std::array<ECBlocks, 4>& ecBlocks)
+		: _versionNumber(versionNumber),
+		  _numAlignmentPatternCenters(static_cast<int>(alignmentPatternCenters.size())),
+		  _ecBlocks(ecBlocks),
+		  _totalCodewords(ecBlocks[0].totalDataCodewords()),
+		  _isMicro(false)
+	{
+		int i = 0;
+		for (int c : alignmentPatternCenters)
+			_alignmentPatternCenters[i++] = c;
+	}
+	constexpr Version(int versionNumber, const std::array<ECBlocks, 4>& ecBlocks)
+		: _versionNumber(versionNumber), _ecBlocks(ecBlocks), _totalCodewords(ecBlocks[0].totalDataCodewords()), _isMicro(true)
+	{}
 	static const Version* AllVersions();
 	static const Version* AllMicroVersions();
 };
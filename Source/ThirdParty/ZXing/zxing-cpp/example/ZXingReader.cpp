@@ -39,6 +39,7 @@ static void PrintUsage(const char* exePath)
 			  << "               Text mode used to render the raw byte content into text\n"
 			  << "    -1         Print only file name, content/error on one line per file/barcode (implies '-mode Escaped')\n"
 			  << "    -bytes     Write (only) the bytes content of the symbol(s) to stdout\n"
+			  << "    -stats     Print per-stage timings and counters (requires a BUILD_DECODE_STATS build)\n"
 			  << "    -pngout <file name>\n"
 			  << "               Write a copy of the input image with barcodes outlined by a green line\n"
 			  << "    -help      Print usage information\n"
@@ -51,7 +52,7 @@ static void PrintUsage(const char* exePath)
 	std::cout << "Formats can be lowercase, with or without '-', separated by ',' and/or '|'\n";
 }
 
-static bool ParseOptions(int argc, char* argv[], DecodeHints& hints, bool& oneLine, bool& bytesOnly,
+static bool ParseOptions(int argc, char* argv[], DecodeHints& hints, bool& oneLine, bool& bytesOnly, bool& printStats,
 						 std::vector<std::string>& filePaths, std::string& outPath)
 {
 #ifdef BUILD_EXPERIMENTAL_API
@@ -102,6 +103,8 @@ static bool ParseOptions(int argc, char* argv[], DecodeHints& hints, bool& oneLi
 			oneLine = true;
 		} else if (is("-bytes")) {
 			bytesOnly = true;
+		} else if (is("-stats")) {
+			printStats = true;
 		} else if (is("-pngout")) {
 			if (++i == argc)
 				return false;
@@ -157,12 +160,13 @@ int main(int argc, char* argv[])
 	std::string outPath;
 	bool oneLine = false;
 	bool bytesOnly = false;
+	bool printStats = false;
 	int ret = 0;
 
 	hints.setTextMode(TextMode::HRI);
 	hints.setEanAddOnSymbol(EanAddOnSymbol::Read);
 
-	if (!ParseOptions(argc, argv, hints, oneLine, bytesOnly, filePaths, outPath)) {
+	if (!ParseOptions(argc, argv, hints, oneLine, bytesOnly, printStats, filePaths, outPath)) {
 		PrintUsage(argv[0]);
 		return -1;
 	}
@@ -179,7 +183,8 @@ int main(int argc, char* argv[])
 		}
 
 		ImageView image{buffer.get(), width, height, ImageFormat::RGB};
-		auto results = ReadBarcodes(image, hints);
+		DecodeStats stats;
+		auto results = ReadBarcodes(image, hints, stats);
 
 		// if we did not find anything, insert a dummy to produce some output for each file
 		if (results.empty())
@@ -272,6 +277,25 @@ int main(int argc, char* argv[])
 				std::cout << "Reader Initialisation/Programming\n";
 		}
 
+		if (printStats) {
+			if (!DecodeStats::IsEnabled())
+				std::cerr << "Note: the library has been built without BUILD_DECODE_STATS\n";
+			for (int i = 0; i < DecodeStats::NumStages; ++i) {
+				auto stage = DecodeStats::Stage(i);
+				std::cout << "Stage:      " << ToString(stage) << " " << stats.nanoseconds(stage) / 1000 << " us";
+				if (stage == DecodeStats::Stage::Detection || stage == DecodeStats::Stage::Decoding)
+					for (auto f : hints.formats().empty() ? BarcodeFormats::all() : hints.formats())
+						if (auto ns = stats.nanoseconds(stage, f))
+							std::cout << ", " << ToString(f) << " " << ns / 1000 << " us";
+				if (stage == DecodeStats::Stage::Binarization && stats.numberOfLayers() > 1)
+					for (int l = 0; l < stats.numberOfLayers(); ++l)
+						std::cout << ", layer " << l << " " << stats.binarizationNanoseconds(l) / 1000 << " us";
+				std::cout << "\n";
+			}
+			for (int i = 0; i < DecodeStats::NumCounters; ++i)
+				std::cout << "Counter:    " << ToString(DecodeStats::Counter(i)) << " " << stats.count(DecodeStats::Counter(i)) << "\n";
+		}
+
 		if (Size(filePaths) == 1 && !outPath.empty())
 			stbi_write_png(outPath.c_str(), image.width(), image.height(), 3, image.data(0, 0), image.rowStride());
 
@@ -0,0 +1,90 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "GlobalHistogramBinarizer.h"
+#include "HybridBinarizer.h"
+#include "Pattern.h"
+#include "SyntheticImage.h"
+#include "ThresholdBinarizer.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace ZXing;
+using namespace ZXing::Benchmark;
+
+static SyntheticImage ImageFor(const benchmark::State& state)
+{
+	return CreateImage(BarcodeFormat::QRCode, SampleText(BarcodeFormat::QRCode), state.range(0), Distortion(state.range(1)));
+}
+
+template <typename B>
+static void BM_Binarizer(benchmark::State& state)
+{
+	auto img = ImageFor(state);
+	for (auto _ : state) {
+		// the BitMatrix is cached in the BinaryBitmap, so it needs to be recreated every iteration
+		B bitmap(img.view());
+		benchmark::DoNotOptimize(bitmap.getBitMatrix());
+	}
+	state.SetItemsProcessed(state.iterations() * img.width * img.height);
+}
+
+static void BM_HybridBinarizer(benchmark::State& state)
+{
+	BM_Binarizer<HybridBinarizer>(state);
+}
+BENCHMARK(BM_HybridBinarizer)->Apply(ImageArgs);
+
+static void BM_GlobalHistogramBinarizer(benchmark::State& state)
+{
+	BM_Binarizer<GlobalHistogramBinarizer>(state);
+}
+BENCHMARK(BM_GlobalHistogramBinarizer)->Apply(ImageArgs);
+
+static void BM_ThresholdBinarizer(benchmark::State& state)
+{
+	auto img = ImageFor(state);
+	for (auto _ : state) {
+		ThresholdBinarizer bitmap(img.view(), 127);
+		benchmark::DoNotOptimize(bitmap.getBitMatrix());
+	}
+	state.SetItemsProcessed(state.iterations() * img.width * img.height);
+}
+BENCHMARK(BM_ThresholdBinarizer)->Apply(ImageArgs);
+
+// row extraction as used by the linear readers (no BitMatrix involved)
+template <typename B>
+static void BM_BinarizerPatternRows(benchmark::State& state)
+{
+	auto img = CreateImage(BarcodeFormat::Code128, SampleText(BarcodeFormat::Code128), state.range(0), Distortion(state.range(1)));
+	PatternRow bars;
+	for (auto _ : state) {
+		B bitmap(img.view());
+		for (int y = 0; y < img.height; ++y)
+			benchmark::DoNotOptimize(bitmap.getPatternRow(y, 0, bars));
+	}
+	state.SetItemsProcessed(state.iterations() * img.width * img.height);
+}
+
+static void BM_GlobalHistogramPatternRows(benchmark::State& state)
+{
+	BM_BinarizerPatternRows<GlobalHistogramBinarizer>(state);
+}
+BENCHMARK(BM_GlobalHistogramPatternRows)->Apply(ImageArgs);
+
+static void BM_GetPatternRow(benchmark::State& state)
+{
+	auto img = CreateImage(BarcodeFormat::Code128, SampleText(BarcodeFormat::Code128), state.range(0), Distortion(state.range(1)));
+	auto bits = HybridBinarizer(img.view()).getBitMatrix()->copy();
+	PatternRow bars;
+	for (auto _ : state)
+		for (int y = 0; y < bits.height(); ++y) {
+			GetPatternRow(bits.row(y), bars);
+			benchmark::DoNotOptimize(bars.data());
+		}
+	state.SetItemsProcessed(state.iterations() * bits.width() * bits.height());
+}
+BENCHMARK(BM_GetPatternRow)->Apply(ImageArgs);
@@ -0,0 +1,49 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "DetectorResult.h"
+#include "GridSampler.h"
+#include "HybridBinarizer.h"
+#include "PerspectiveTransform.h"
+#include "SyntheticImage.h"
+#include "qrcode/QRDetector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <stdexcept>
+
+using namespace ZXing;
+using namespace ZXing::Benchmark;
+
+static void BM_QRFindFinderPatterns(benchmark::State& state)
+{
+	auto img = CreateImage(BarcodeFormat::QRCode, SampleText(BarcodeFormat::QRCode), state.range(0), Distortion(state.range(1)));
+	auto bits = HybridBinarizer(img.view()).getBitMatrix()->copy();
+	for (auto _ : state) {
+		auto fps = QRCode::FindFinderPatterns(bits, true);
+		if (fps.size() < 3)
+			state.SkipWithError("finder patterns not found");
+		benchmark::DoNotOptimize(fps.data());
+	}
+	state.SetItemsProcessed(state.iterations() * bits.width() * bits.height());
+}
+BENCHMARK(BM_QRFindFinderPatterns)->Apply(ImageArgs);
+
+static void BM_SampleGrid(benchmark::State& state)
+{
+	auto img = CreateImage(BarcodeFormat::QRCode, SampleText(BarcodeFormat::QRCode), state.range(0), Distortion(state.range(1)));
+	auto bits = HybridBinarizer(img.view()).getBitMatrix()->copy();
+	// the known geometry of the symbol saves us from running the detector
+	PerspectiveTransform mod2Pix(Rectangle(img.modules, img.modules), img.symbol);
+	for (auto _ : state) {
+		auto res = SampleGrid(bits, img.modules, img.modules, mod2Pix);
+		if (!res.isValid())
+			state.SkipWithError("grid sampling failed");
+		benchmark::DoNotOptimize(res.bits().row(0).begin());
+	}
+	state.SetItemsProcessed(state.iterations() * img.modules * img.modules);
+}
+BENCHMARK(BM_SampleGrid)->Apply(ImageArgs);
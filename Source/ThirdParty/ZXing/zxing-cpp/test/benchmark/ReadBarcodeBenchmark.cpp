@@ -0,0 +1,37 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ReadBarcode.h"
+#include "SyntheticImage.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace ZXing;
+using namespace ZXing::Benchmark;
+
+// Full ReadBarcodes call restricted to the format of the symbol in the image.
+// Args: module size in pixels, Distortion
+static void BM_ReadBarcodes(benchmark::State& state, BarcodeFormat format)
+{
+	auto img = CreateImage(format, SampleText(format), state.range(0), Distortion(state.range(1)));
+	auto hints = DecodeHints().setFormats(format);
+	for (auto _ : state) {
+		auto results = ReadBarcodes(img.view(), hints);
+		if (results.empty())
+			state.SkipWithError("symbol not found");
+		benchmark::DoNotOptimize(results.data());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+static int RegisterReadBarcodeBenchmarks()
+{
+	for (auto format : WritableFormats()) {
+		benchmark::RegisterBenchmark(("BM_ReadBarcodes/" + ToString(format)).c_str(), BM_ReadBarcodes, format)->Apply(ImageArgs);
+	}
+	return 0;
+}
+
+static int registered = RegisterReadBarcodeBenchmarks();
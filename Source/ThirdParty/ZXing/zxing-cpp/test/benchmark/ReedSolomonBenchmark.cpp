@@ -0,0 +1,82 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "GenericGF.h"
+#include "ReedSolomonDecoder.h"
+#include "ReedSolomonEncoder.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ZXing;
+
+// Decode a code word of (at most) 255 symbols with 1/4 of them being EC code words, either without errors or with
+// half of the correctable number of errors or with the maximum number of correctable errors.
+static void BM_ReedSolomonDecode(benchmark::State& state, const GenericGF& field)
+{
+	const int length = std::min(field.size() - 1, 255);
+	const int numECCodeWords = std::max(2, length / 4 / 2 * 2);
+	const int numErrors = numECCodeWords / 2 * state.range(0) / 2;
+
+	std::minstd_rand random(42);
+	std::vector<int> message(length);
+	for (auto& v : message)
+		v = std::uniform_int_distribution<int>(0, field.size() - 1)(random);
+	ReedSolomonEncode(field, message, numECCodeWords);
+
+	auto received = message;
+	std::vector<int> positions(length);
+	for (int i = 0; i < length; ++i)
+		positions[i] = i;
+	std::shuffle(positions.begin(), positions.end(), random);
+	for (int i = 0; i < numErrors; ++i)
+		received[positions[i]] ^= std::uniform_int_distribution<int>(1, field.size() - 1)(random);
+
+	std::vector<int> work;
+	for (auto _ : state) {
+		work = received;
+		if (!ReedSolomonDecode(field, work, numECCodeWords) || work != message)
+			state.SkipWithError("decoding failed");
+	}
+	state.SetItemsProcessed(state.iterations() * length);
+}
+
+// Encode a code word of (at most) 255 symbols with Arg EC code words
+static void BM_ReedSolomonEncode(benchmark::State& state, const GenericGF& field)
+{
+	const int length = std::min(field.size() - 1, 255);
+	const int numECCodeWords = state.range(0);
+
+	std::minstd_rand random(42);
+	std::vector<int> message(length);
+	for (auto& v : message)
+		v = std::uniform_int_distribution<int>(0, field.size() - 1)(random);
+
+	for (auto _ : state) {
+		ReedSolomonEncode(field, message, numECCodeWords);
+		benchmark::DoNotOptimize(message.data());
+	}
+	state.SetItemsProcessed(state.iterations() * length);
+}
+
+BENCHMARK_CAPTURE(BM_ReedSolomonEncode, QRCodeField256, GenericGF::QRCodeField256())->Arg(10)->Arg(30)->ArgName("ec");
+BENCHMARK_CAPTURE(BM_ReedSolomonEncode, DataMatrixField256, GenericGF::DataMatrixField256())->Arg(10)->Arg(68)->ArgName("ec");
+BENCHMARK_CAPTURE(BM_ReedSolomonEncode, AztecData12, GenericGF::AztecData12())->Arg(10)->Arg(100)->ArgName("ec");
+
+// Arg: error level 0 (none), 1 (half of the correctable), 2 (all correctable)
+#define RS_BENCHMARK(FIELD) \
+	BENCHMARK_CAPTURE(BM_ReedSolomonDecode, FIELD, GenericGF::FIELD())->DenseRange(0, 2)->ArgName("errors")
+
+RS_BENCHMARK(QRCodeField256);
+RS_BENCHMARK(DataMatrixField256);
+RS_BENCHMARK(AztecData6);
+RS_BENCHMARK(AztecData8);
+RS_BENCHMARK(AztecData10);
+RS_BENCHMARK(AztecData12);
+RS_BENCHMARK(AztecParam);
+RS_BENCHMARK(MaxiCodeField64);
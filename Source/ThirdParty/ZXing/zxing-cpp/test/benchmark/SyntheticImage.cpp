@@ -0,0 +1,118 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "SyntheticImage.h"
+
+#include "BitMatrix.h"
+#include "MultiFormatWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace ZXing::Benchmark {
+
+static constexpr int QuietZone = 10;
+static constexpr int LinearHeight = 30; // in modules
+static constexpr double RotationAngle = 5 * 3.14159265358979 / 180;
+
+SyntheticImage CreateImage(BarcodeFormat format, const std::string& text, int moduleSize, Distortion distortion)
+{
+	auto bits = MultiFormatWriter(format).setMargin(0).encode(text, 0, 0);
+	const bool isLinear = bits.height() == 1;
+	const int rows = isLinear ? LinearHeight : bits.height();
+
+	SyntheticImage res;
+	res.modules = bits.width();
+	res.width = (bits.width() + 2 * QuietZone) * moduleSize;
+	res.height = (rows + 2 * QuietZone) * moduleSize;
+
+	const PointF center(res.width / 2., res.height / 2.);
+	const double angle = distortion == Distortion::Rotated ? RotationAngle : 0;
+	auto rotate = [&](PointF p, double a) {
+		p = p - center;
+		return PointF(p.x * std::cos(a) - p.y * std::sin(a), p.x * std::sin(a) + p.y * std::cos(a)) + center;
+	};
+
+	auto sample = [&](PointF p) -> double {
+		int x = static_cast<int>(std::floor(p.x / moduleSize)) - QuietZone;
+		int y = static_cast<int>(std::floor(p.y / moduleSize)) - QuietZone;
+		if (x < 0 || x >= bits.width() || y < 0 || y >= rows)
+			return 255;
+		return bits.get(x, isLinear ? 0 : y) ? 0 : 255;
+	};
+
+	// render by inverse mapping every pixel center into the (unrotated) symbol
+	res.buffer.resize(res.width * res.height);
+	for (int y = 0; y < res.height; ++y)
+		for (int x = 0; x < res.width; ++x) {
+			auto p = rotate(PointF(x + 0.5, y + 0.5), -angle);
+			double v = sample(p);
+			if (angle != 0) {
+				// bilinear-ish antialiasing: average with the neighbors at half a pixel distance
+				v = (v + sample(p + PointF(0.5, 0)) + sample(p + PointF(0, 0.5)) + sample(p + PointF(0.5, 0.5))) / 4;
+			}
+			res.buffer[y * res.width + x] = static_cast<uint8_t>(v);
+		}
+
+	if (distortion != Distortion::None) {
+		// 3x3 box blur, reduce the contrast to [50, 210] and add uniform noise of +-12
+		std::vector<uint8_t> blurred(res.buffer.size());
+		std::minstd_rand random(42);
+		std::uniform_int_distribution<int> noise(-12, 12);
+		for (int y = 0; y < res.height; ++y)
+			for (int x = 0; x < res.width; ++x) {
+				int sum = 0, n = 0;
+				for (int dy = -1; dy <= 1; ++dy)
+					for (int dx = -1; dx <= 1; ++dx)
+						if (x + dx >= 0 && x + dx < res.width && y + dy >= 0 && y + dy < res.height) {
+							sum += res.buffer[(y + dy) * res.width + x + dx];
+							++n;
+						}
+				int v = 50 + (sum / n) * 160 / 255 + noise(random);
+				blurred[y * res.width + x] = static_cast<uint8_t>(std::clamp(v, 0, 255));
+			}
+		res.buffer = std::move(blurred);
+	}
+
+	auto corner = [&](int x, int y) { return rotate(moduleSize * PointF(x + QuietZone, y + QuietZone), angle); };
+	res.symbol = QuadrilateralF(corner(0, 0), corner(bits.width(), 0), corner(bits.width(), rows), corner(0, rows));
+
+	return res;
+}
+
+std::string SampleText(BarcodeFormat format)
+{
+	switch (format) {
+	case BarcodeFormat::Codabar: return "A0123456789B";
+	case BarcodeFormat::Code39: return "ZXING-CPP 2026";
+	case BarcodeFormat::Code93:
+	case BarcodeFormat::Code128: return "ZXing-C++ 2026";
+	case BarcodeFormat::EAN8: return "9638507";
+	case BarcodeFormat::EAN13: return "400638133393";
+	case BarcodeFormat::ITF: return "00123456789012";
+	case BarcodeFormat::UPCA: return "72527273070";
+	case BarcodeFormat::UPCE: return "0123456";
+	default: return "Hello World! ZXing-C++ benchmark 0123456789";
+	}
+}
+
+BarcodeFormats WritableFormats()
+{
+	return BarcodeFormat::Aztec | BarcodeFormat::Codabar | BarcodeFormat::Code39 | BarcodeFormat::Code93
+		   | BarcodeFormat::Code128 | BarcodeFormat::DataMatrix | BarcodeFormat::EAN8 | BarcodeFormat::EAN13
+		   | BarcodeFormat::ITF | BarcodeFormat::PDF417 | BarcodeFormat::QRCode | BarcodeFormat::UPCA
+		   | BarcodeFormat::UPCE;
+}
+
+void ImageArgs(benchmark::internal::Benchmark* b)
+{
+	for (int moduleSize : {4, 6, 8})
+		for (int distortion : {0, 1, 2})
+			b->Args({moduleSize, distortion});
+	b->ArgNames({"moduleSize", "distortion"});
+}
+
+} // namespace ZXing::Benchmark
@@ -0,0 +1,52 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BarcodeFormat.h"
+#include "ImageView.h"
+#include "Quadrilateral.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ZXing::Benchmark {
+
+enum class Distortion
+{
+	None,     ///< perfect black on white modules
+	Noisy,    ///< blurred, reduced contrast and random noise
+	Rotated,  ///< like Noisy plus a small rotation (bilinear interpolation)
+};
+
+/**
+ * A greyscale image of a single symbol rendered by the writers, with a quiet zone of 10 modules around it.
+ */
+struct SyntheticImage
+{
+	int width = 0, height = 0;
+	std::vector<uint8_t> buffer;
+	int modules = 0;        ///< width of the symbol in modules (for 2D symbols also the height)
+	QuadrilateralF symbol;  ///< corners of the symbol in pixel coordinates
+
+	ImageView view() const { return {buffer.data(), width, height, ImageFormat::Lum}; }
+};
+
+SyntheticImage CreateImage(BarcodeFormat format, const std::string& text, int moduleSize, Distortion distortion);
+
+// some valid content for all formats that have a writer
+std::string SampleText(BarcodeFormat format);
+
+// all formats that can be generated with the MultiFormatWriter
+BarcodeFormats WritableFormats();
+
+// Registers the argument pairs {module size in pixels, Distortion} used by all image based benchmarks. With a 3x3 blur,
+// module sizes below 4 pixels are not reliably decodable anymore.
+void ImageArgs(benchmark::internal::Benchmark* b);
+
+} // namespace ZXing::Benchmark
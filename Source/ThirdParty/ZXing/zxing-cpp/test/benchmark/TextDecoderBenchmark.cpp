@@ -0,0 +1,38 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "CharacterSet.h"
+#include "TextDecoder.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+
+static void BM_TextDecoderAppend(benchmark::State& state, CharacterSet charset, std::string sample)
+{
+	// repeat the sample to get about 1000 bytes of input
+	std::string input;
+	while (input.size() < 1000)
+		input += sample;
+	std::vector<uint8_t> bytes(input.begin(), input.end());
+
+	std::string str;
+	for (auto _ : state) {
+		str.clear();
+		TextDecoder::Append(str, bytes.data(), bytes.size(), charset);
+		benchmark::DoNotOptimize(str.data());
+	}
+	state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+BENCHMARK_CAPTURE(BM_TextDecoderAppend, ASCII, CharacterSet::ASCII, "Hello World! 0123456789");
+BENCHMARK_CAPTURE(BM_TextDecoderAppend, ISO8859_1, CharacterSet::ISO8859_1, "Gr\xFC\xDF" "e aus K\xF6ln, 12\xB0");
+BENCHMARK_CAPTURE(BM_TextDecoderAppend, UTF8, CharacterSet::UTF8, "Gr\xC3\xBC\xC3\x9F" "e, \xE6\x97\xA5\xE6\x9C\xAC, 12\xC2\xB0");
+BENCHMARK_CAPTURE(BM_TextDecoderAppend, Shift_JIS, CharacterSet::Shift_JIS, "\x93\xFA\x96\x7B\x8C\xEA abc ");
+BENCHMARK_CAPTURE(BM_TextDecoderAppend, GB18030, CharacterSet::GB18030, "\xD6\xD0\xCE\xC4 abc ");
+BENCHMARK_CAPTURE(BM_TextDecoderAppend, Binary, CharacterSet::BINARY, std::string("\x00\x01\x80\xFF", 4));
@@ -0,0 +1,117 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "DecodeStats.h"
+#include "MultiFormatWriter.h"
+#include "ReadBarcode.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace ZXing;
+using Stage = DecodeStats::Stage;
+using Counter = DecodeStats::Counter;
+
+static std::vector<uint8_t> DrawQRCode(int size)
+{
+	auto bits = MultiFormatWriter(BarcodeFormat::QRCode).encode("stats", size, size);
+	std::vector<uint8_t> buffer(size * size);
+	for (int y = 0; y < size; ++y)
+		for (int x = 0; x < size; ++x)
+			buffer[y * size + x] = bits.get(x, y) ? 0 : 0xFF;
+	return buffer;
+}
+
+TEST(DecodeStatsTest, ReadBarcodes)
+{
+	auto buffer = DrawQRCode(100);
+	ImageView iv(buffer.data(), 100, 100, ImageFormat::Lum);
+	auto hints = DecodeHints().setFormats(BarcodeFormat::QRCode | BarcodeFormat::Code128);
+
+	DecodeStats stats;
+	auto results = ReadBarcodes(iv, hints, stats);
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_EQ(results[0].text(), "stats");
+
+	if (!DecodeStats::IsEnabled()) {
+		for (int i = 0; i < DecodeStats::NumStages; ++i)
+			EXPECT_EQ(stats.nanoseconds(Stage(i)), 0);
+		for (int i = 0; i < DecodeStats::NumCounters; ++i)
+			EXPECT_EQ(stats.count(Counter(i)), 0);
+		return;
+	}
+
+	EXPECT_GT(stats.nanoseconds(Stage::Binarization), 0);
+	EXPECT_GT(stats.nanoseconds(Stage::Detection, BarcodeFormat::QRCode), 0);
+	EXPECT_GT(stats.nanoseconds(Stage::Decoding, BarcodeFormat::QRCode), 0);
+	EXPECT_GT(stats.nanoseconds(Stage::Decoding, BarcodeFormat::Code128), 0);
+	EXPECT_EQ(stats.nanoseconds(Stage::Decoding, BarcodeFormat::Aztec), 0);
+	EXPECT_EQ(stats.nanoseconds(Stage::Decoding),
+			  stats.nanoseconds(Stage::Decoding, BarcodeFormat::QRCode) + stats.nanoseconds(Stage::Decoding, BarcodeFormat::Code128));
+
+	EXPECT_GE(stats.count(Counter::FinderPatternCandidates), 3);
+	EXPECT_GE(stats.count(Counter::FinderPatternSetsSampled), 1);
+	EXPECT_GT(stats.count(Counter::RowsScanned), 0);
+	EXPECT_EQ(stats.numberOfLayers(), 1);
+	EXPECT_EQ(stats.binarizationNanoseconds(0), stats.nanoseconds(Stage::Binarization));
+
+	// the values are accumulated
+	auto first = stats;
+	ReadBarcodes(iv, hints, stats);
+	EXPECT_EQ(stats.count(Counter::RowsScanned), 2 * first.count(Counter::RowsScanned));
+	EXPECT_GT(stats.nanoseconds(Stage::Detection), first.nanoseconds(Stage::Detection));
+
+	first += first;
+	EXPECT_EQ(first.count(Counter::FinderPatternCandidates), stats.count(Counter::FinderPatternCandidates));
+
+	stats.reset();
+	EXPECT_EQ(stats.nanoseconds(Stage::Detection), 0);
+	EXPECT_EQ(stats.count(Counter::RowsScanned), 0);
+}
+
+TEST(DecodeStatsTest, Batch)
+{
+	auto buffer = DrawQRCode(100);
+	std::vector<ImageView> views(4, ImageView(buffer.data(), 100, 100, ImageFormat::Lum));
+
+	BatchStats stats;
+	ReadBarcodesBatch(views, DecodeHints().setFormats(BarcodeFormat::QRCode), 2, &stats);
+
+	DecodeStats single;
+	ReadBarcodes(views[0], DecodeHints().setFormats(BarcodeFormat::QRCode), single);
+	EXPECT_EQ(stats.decode.count(Counter::FinderPatternCandidates), 4 * single.count(Counter::FinderPatternCandidates));
+}
+
+TEST(DecodeStatsTest, Layers)
+{
+	auto buffer = DrawQRCode(400);
+	ImageView iv(buffer.data(), 400, 400, ImageFormat::Lum);
+	// make sure the symbol is not found before all layers have been binarized
+	auto hints = DecodeHints().setFormats(BarcodeFormat::Aztec).setDownscaleThreshold(150).setDownscaleFactor(2);
+
+	DecodeStats stats;
+	ReadBarcodes(iv, hints, stats);
+
+	if (!DecodeStats::IsEnabled()) {
+		EXPECT_EQ(stats.numberOfLayers(), 0);
+		return;
+	}
+
+	// 400 -> 200 -> 100
+	ASSERT_EQ(stats.numberOfLayers(), 3);
+	int64_t sum = 0;
+	for (int i = 0; i < stats.numberOfLayers(); ++i) {
+		EXPECT_GT(stats.binarizationNanoseconds(i), 0);
+		sum += stats.binarizationNanoseconds(i);
+	}
+	EXPECT_EQ(sum, stats.nanoseconds(Stage::Binarization));
+	EXPECT_EQ(stats.binarizationNanoseconds(3), 0);
+
+	auto twice = stats;
+	twice += stats;
+	EXPECT_EQ(twice.binarizationNanoseconds(2), 2 * stats.binarizationNanoseconds(2));
+}
@@ -0,0 +1,84 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "GridSampler.h"
+#include "PseudoRandom.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace ZXing;
+
+// the straight forward per module implementation SampleGrid has to be identical to
+static BitMatrix SampleGridReference(const BitMatrix& image, int width, int height, const PerspectiveTransform& mod2Pix)
+{
+	BitMatrix res(width, height);
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x) {
+			auto p = mod2Pix(centered(PointI{x, y}));
+			if (!image.isIn(p))
+				return {};
+			if (image.get(p))
+				res.set(x, y);
+		}
+	return res;
+}
+
+TEST(GridSamplerTest, ProjectRow)
+{
+	PseudoRandom rnd(42);
+	for (int n = 0; n < 100; ++n) {
+		auto quad = [&] {
+			QuadrilateralF q;
+			for (auto& p : q)
+				p = {rnd.next(-100000, 100000) / 100., rnd.next(-100000, 100000) / 100.};
+			return q;
+		};
+		PerspectiveTransform mod2Pix(quad(), quad());
+		std::vector<double> xs(30), ys(30);
+		for (int y = -5; y < 25; ++y) {
+			mod2Pix.projectRow(-3, 27, y, xs.data(), ys.data());
+			for (int i = 0; i < 30; ++i) {
+				auto p = mod2Pix(centered(PointI{i - 3, y}));
+				// compare the bits to treat nan == nan
+				EXPECT_EQ(std::memcmp(&p.x, &xs[i], sizeof(double)), 0);
+				EXPECT_EQ(std::memcmp(&p.y, &ys[i], sizeof(double)), 0);
+			}
+		}
+	}
+}
+
+TEST(GridSamplerTest, SampleGrid)
+{
+	PseudoRandom rnd(42);
+	BitMatrix image(300, 200);
+	for (int y = 0; y < image.height(); ++y)
+		for (int x = 0; x < image.width(); ++x)
+			if (rnd.next(0, 1))
+				image.set(x, y);
+
+	int sampled = 0;
+	for (int n = 0; n < 500; ++n) {
+		const int size = rnd.next(10, 150);
+		// distorted versions of a rectangle that is sometimes partially outside the image
+		auto dst = Rectangle(20, 280, 20, 180, 0.);
+		for (auto& p : dst)
+			p += PointF(rnd.next(-2500, 2500) / 100., rnd.next(-2500, 2500) / 100.);
+		PerspectiveTransform mod2Pix(Rectangle(size, size, 0), dst);
+		if (!mod2Pix.isValid())
+			continue;
+
+		auto expected = SampleGridReference(image, size, size, mod2Pix);
+		auto res = SampleGrid(image, size, size, mod2Pix);
+		ASSERT_EQ(res.isValid(), !expected.empty());
+		if (res.isValid()) {
+			EXPECT_EQ(res.bits(), expected);
+			++sampled;
+		}
+	}
+	EXPECT_GT(sampled, 100);
+}
@@ -0,0 +1,87 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "LineScanReader.h"
+#include "MultiFormatWriter.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace ZXing;
+
+namespace {
+
+// simulate a conveyor belt: white rows with a number of symbols passing by, one after the other
+struct Stream
+{
+	int width;
+	std::vector<std::vector<uint8_t>> rows;
+
+	explicit Stream(int width) : width(width) {}
+
+	void addBlank(int count) { rows.insert(rows.end(), count, std::vector<uint8_t>(width, 0xFF)); }
+
+	void addSymbol(BarcodeFormat format, const std::string& text, int height)
+	{
+		auto bits = MultiFormatWriter(format).encode(text, width, height);
+		for (int y = 0; y < bits.height(); ++y) {
+			std::vector<uint8_t> row(width);
+			for (int x = 0; x < width; ++x)
+				row[x] = bits.get(x, y) ? 0 : 0xFF;
+			rows.push_back(std::move(row));
+		}
+	}
+};
+
+} // namespace
+
+TEST(LineScanReaderTest, Code128)
+{
+	Stream stream(300);
+	stream.addBlank(20);
+	stream.addSymbol(BarcodeFormat::Code128, "first", 30);
+	stream.addBlank(100);
+	stream.addSymbol(BarcodeFormat::Code128, "second", 30);
+	stream.addBlank(20);
+
+	LineScanReader reader(DecodeHints().setFormats(BarcodeFormat::Code128).setMinLineCount(3));
+
+	std::vector<std::pair<int, std::string>> found;
+	for (auto& row : stream.rows)
+		for (auto& r : reader.addRow({row.data(), stream.width, 1, ImageFormat::Lum}))
+			found.emplace_back(reader.rowCount() - 1, r.text());
+
+	// every symbol is reported exactly once, as soon as it has been seen in 3 rows
+	ASSERT_EQ(found.size(), 2);
+	EXPECT_EQ(found[0], std::pair(20 + 2, std::string("first")));
+	EXPECT_EQ(found[1], std::pair(20 + 30 + 100 + 2, std::string("second")));
+	EXPECT_EQ(reader.rowCount(), Size(stream.rows));
+
+	reader.reset();
+	EXPECT_EQ(reader.rowCount(), 0);
+}
+
+TEST(LineScanReaderTest, RGB)
+{
+	Stream stream(300);
+	stream.addSymbol(BarcodeFormat::EAN13, "4006381333931", 10);
+
+	LineScanReader reader(DecodeHints().setFormats(BarcodeFormat::EAN13).setMinLineCount(2));
+
+	Results results;
+	for (auto& row : stream.rows) {
+		std::vector<uint8_t> rgb;
+		for (auto v : row)
+			rgb.insert(rgb.end(), {v, v, v});
+		for (auto& r : reader.addRow({rgb.data(), stream.width, 1, ImageFormat::RGB}))
+			results.push_back(r);
+	}
+
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_EQ(results[0].text(), "4006381333931");
+	EXPECT_EQ(results[0].lineCount(), 2);
+}
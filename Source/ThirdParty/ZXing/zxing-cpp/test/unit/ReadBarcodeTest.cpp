@@ -0,0 +1,233 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "MultiFormatWriter.h"
+#include "ReadBarcode.h"
+
+#include "gtest/gtest.h"
+
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace ZXing;
+
+namespace {
+
+struct TestImage
+{
+	int width, height;
+	std::vector<uint8_t> buffer;
+
+	TestImage(int width, int height) : width(width), height(height), buffer(width * height, 0xFF) {}
+
+	void draw(BarcodeFormat format, const std::string& text, int left, int top, int width, int height)
+	{
+		auto bits = MultiFormatWriter(format).setMargin(0).encode(text, width, height);
+		for (int y = 0; y < bits.height(); ++y)
+			for (int x = 0; x < bits.width(); ++x)
+				if (bits.get(x, y))
+					buffer[(top + y) * this->width + left + x] = 0;
+	}
+
+	ImageView view() const { return {buffer.data(), width, height, ImageFormat::Lum}; }
+};
+
+} // namespace
+
+TEST(ReadBarcodeTest, Tiled)
+{
+	TestImage img(700, 500);
+	img.draw(BarcodeFormat::QRCode, "first", 20, 20, 100, 100);
+	img.draw(BarcodeFormat::QRCode, "second", 300, 200, 100, 100); // crosses the borders of several tiles
+
+	auto hints = DecodeHints().setFormats(BarcodeFormat::QRCode);
+	auto results = ReadBarcodesTiled(img.view(), hints, 256, 128, 2);
+
+	ASSERT_EQ(results.size(), 2);
+	EXPECT_EQ(results[0].text(), "first");
+	EXPECT_EQ(results[1].text(), "second");
+	// the positions need to be given in image (not tile) coordinates
+	EXPECT_EQ(results[1].position().topLeft() - results[0].position().topLeft(), PointI(280, 180));
+	EXPECT_TRUE(IsInside(PointI(70, 70), results[0].position()));
+	EXPECT_TRUE(IsInside(PointI(350, 250), results[1].position()));
+
+	EXPECT_EQ(ReadBarcodesTiled(img.view(), hints.setMaxNumberOfSymbols(1), 256, 128).size(), 1);
+
+	EXPECT_THROW(ReadBarcodesTiled(img.view(), hints, 128, 128), std::invalid_argument);
+}
+
+TEST(ReadBarcodeTest, TiledBeyond16Bit)
+{
+	// ReadBarcodes can not handle linear codes in images wider than 65535 pixels
+	TestImage img(70000, 30);
+	img.draw(BarcodeFormat::Code128, "wide", 68000, 5, 200, 20);
+
+	auto hints = DecodeHints().setFormats(BarcodeFormat::Code128);
+	EXPECT_THROW(ReadBarcodes(img.view(), hints), std::invalid_argument);
+
+	auto results = ReadBarcodesTiled(img.view(), hints, 1024, 256);
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_EQ(results[0].text(), "wide");
+	EXPECT_GE(results[0].position().topLeft().x, 68000);
+	EXPECT_LT(results[0].position().topRight().x, 68200);
+}
+
+TEST(ReadBarcodeTest, TiledBeyond2GiB)
+{
+	// the byte offset of the tiles at the bottom of an 80000 rows RGB scan is way beyond INT_MAX, check the pointer
+	// arithmetic of the views ReadBarcodesTiled works on without actually allocating the image
+	const int width = 30000, height = 80000, rowStride = 3 * width;
+	uint8_t dummy = 0;
+	ImageView iv(&dummy, width, height, ImageFormat::RGB);
+	auto offset = [&iv](const ImageView& v, int x = 0, int y = 0) { return v.data(x, y) - iv.data(0, 0); };
+
+	const ptrdiff_t top = ptrdiff_t(height - 1024) * rowStride, left = ptrdiff_t(width - 1024) * 3;
+	ASSERT_GT(top, INT_MAX);
+	auto tile = iv.cropped(width - 1024, height - 1024, 1024, 1024);
+	EXPECT_EQ(offset(tile), top + left);
+	EXPECT_EQ(offset(tile, 1023, 1023), top + left + 1023 * rowStride + 1023 * 3);
+	EXPECT_EQ(offset(iv.rotated(90)), ptrdiff_t(height - 1) * rowStride);
+	EXPECT_EQ(offset(iv.rotated(180)), ptrdiff_t(height - 1) * rowStride + (width - 1) * 3);
+	EXPECT_EQ(offset(iv.rotated(90), height - 1, width - 1), offset(iv, width - 1, 0));
+
+	EXPECT_EQ(iv.subsampled(8).rowStride(), 8 * rowStride);
+	EXPECT_THROW(ImageView(&dummy, width, 10, ImageFormat::RGB, INT_MAX / 2).subsampled(4), std::invalid_argument);
+}
+
+TEST(ReadBarcodeTest, Batch)
+{
+	std::vector<TestImage> imgs;
+	for (int i = 0; i < 7; ++i) {
+		imgs.emplace_back(100 + 60 * i, 100 + 40 * i);
+		if (i != 3)
+			imgs.back().draw(BarcodeFormat::QRCode, std::to_string(i), 10 + i, 10, 80, 80);
+	}
+	std::vector<ImageView> views;
+	for (auto& img : imgs)
+		views.push_back(img.view());
+
+	auto hints = DecodeHints().setFormats(BarcodeFormat::QRCode);
+	BatchStats stats;
+	auto results = ReadBarcodesBatch(views, hints, 3, &stats);
+
+	// the results are in input order and equal to decoding the images one by one
+	ASSERT_EQ(results.size(), imgs.size());
+	for (int i = 0; i < Size(imgs); ++i) {
+		auto expected = ReadBarcodes(views[i], hints);
+		ASSERT_EQ(results[i].size(), expected.size());
+		EXPECT_EQ(results[i].size(), i == 3 ? 0 : 1);
+		if (!expected.empty()) {
+			EXPECT_EQ(results[i][0].text(), std::to_string(i));
+			EXPECT_EQ(results[i][0].position(), expected[0].position());
+		}
+	}
+
+	EXPECT_EQ(stats.images, 7);
+	EXPECT_EQ(stats.symbols, 6);
+	EXPECT_GT(stats.seconds, 0);
+
+	ReadBarcodesBatch(views, hints, 1, &stats);
+	EXPECT_EQ(stats.images, 14);
+
+	EXPECT_TRUE(ReadBarcodesBatch({}, hints).empty());
+}
+
+TEST(ReadBarcodeTest, LinearParallel)
+{
+	// a parcel label like image with linear codes spread over the full height, some of them close to each other
+	TestImage img(600, 1200);
+	img.draw(BarcodeFormat::Code128, "parcel", 20, 30, 300, 60);
+	img.draw(BarcodeFormat::EAN13, "4006381333931", 350, 90, 200, 80);
+	img.draw(BarcodeFormat::Code39, "LABEL-1", 40, 400, 400, 40);
+	img.draw(BarcodeFormat::Code128, "12345678", 40, 580, 250, 25);
+	img.draw(BarcodeFormat::ITF, "00123456789012", 30, 900, 500, 100);
+	img.draw(BarcodeFormat::Code93, "END", 300, 1100, 200, 50);
+
+	for (int maxSymbols : {0, 1, 3}) {
+		auto hints = DecodeHints().setFormats(BarcodeFormat::LinearCodes).setMaxNumberOfSymbols(maxSymbols ? maxSymbols : 0xff);
+		auto expected = ReadBarcodes(img.view(), hints);
+		EXPECT_EQ(Size(expected), maxSymbols ? maxSymbols : 6);
+
+		// the results do not depend on the number of threads scanning the rows
+		for (int numThreads : {0, 2, 3, 7}) {
+			auto results = ReadBarcodes(img.view(), DecodeHints(hints).setMaxNumberOfThreads(numThreads));
+			ASSERT_EQ(results.size(), expected.size());
+			for (size_t i = 0; i < results.size(); ++i) {
+				EXPECT_EQ(results[i].text(), expected[i].text());
+				EXPECT_EQ(results[i].position(), expected[i].position());
+				EXPECT_EQ(results[i].lineCount(), expected[i].lineCount());
+			}
+		}
+	}
+}
+
+TEST(ReadBarcodeTest, AngledScanLines)
+{
+	constexpr double PI = 3.14159265358979323846;
+	// a symbol that is too short to be crossed completely by any horizontal or vertical scan line once it is tilted
+	auto bits = MultiFormatWriter(BarcodeFormat::EAN13).encode("4006381333931", 300, 90);
+
+	for (int degrees : {30, -60}) {
+		TestImage img(500, 500);
+		double c = std::cos(degrees * PI / 180), s = std::sin(degrees * PI / 180);
+		for (int y = 0; y < img.height; ++y)
+			for (int x = 0; x < img.width; ++x) {
+				// rotate the symbol around the center of the image
+				int u = std::lround(c * (x - 250) + s * (y - 250) + bits.width() / 2);
+				int v = std::lround(-s * (x - 250) + c * (y - 250) + bits.height() / 2);
+				if (bits.isIn(PointI(u, v)) && bits.get(u, v))
+					img.buffer[y * img.width + x] = 0;
+			}
+
+		auto hints = DecodeHints().setFormats(BarcodeFormat::EAN13);
+		EXPECT_TRUE(ReadBarcodes(img.view(), hints).empty());
+
+		auto results = ReadBarcodes(img.view(), hints.setScanLineAngles(2));
+		ASSERT_EQ(results.size(), 1);
+		EXPECT_EQ(results[0].text(), "4006381333931");
+		EXPECT_EQ(results[0].orientation(), degrees);
+		EXPECT_GT(results[0].lineCount(), 2);
+		EXPECT_TRUE(IsInside(PointI(250, 250), results[0].position()));
+	}
+}
+
+TEST(ReadBarcodeTest, SubPixelEdges)
+{
+	auto bits = MultiFormatWriter(BarcodeFormat::Code128).setMargin(10).encode("SUBPIXEL EDGES 1234", 0, 1);
+
+	for (double pixPerModule : {1.3, 1.4, 1.6}) {
+		// render the symbol with a box filter, i.e. every pixel gets the average luminance of the modules it covers
+		const int length = narrow_cast<int>(bits.width() * pixPerModule);
+		std::vector<uint8_t> line(length);
+		for (int i = 0; i < length; ++i) {
+			double a = i / pixPerModule, b = (i + 1) / pixPerModule, black = 0;
+			for (int m = int(a); m <= int(b) && m < bits.width(); ++m)
+				if (bits.get(m, 0))
+					black += std::min(b, m + 1.0) - std::max(a, double(m));
+			line[i] = narrow_cast<uint8_t>(std::lround(255 - 255 * black / (b - a)));
+		}
+
+		for (bool vertical : {false, true}) {
+			TestImage img(vertical ? 20 : length, vertical ? length : 20);
+			for (int y = 0; y < img.height; ++y)
+				for (int x = 0; x < img.width; ++x)
+					img.buffer[y * img.width + x] = line[vertical ? y : x];
+
+			auto hints = DecodeHints().setFormats(BarcodeFormat::Code128);
+			EXPECT_TRUE(ReadBarcodes(img.view(), hints).empty());
+
+			auto results = ReadBarcodes(img.view(), hints.setSubPixelEdges(true));
+			ASSERT_EQ(results.size(), 1);
+			EXPECT_EQ(results[0].text(), "SUBPIXEL EDGES 1234");
+			EXPECT_EQ(results[0].orientation(), vertical ? 90 : 0);
+			for (auto p : results[0].position())
+				EXPECT_TRUE(p.x >= 0 && p.x < img.width && p.y >= 0 && p.y < img.height);
+		}
+	}
+}
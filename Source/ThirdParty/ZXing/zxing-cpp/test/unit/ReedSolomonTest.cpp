@@ -11,6 +11,8 @@
 
 #include <algorithm>
 #include <ostream>
+#include <thread>
+#include <vector>
 
 static std::ostream& operator<<(std::ostream& out, const ZXing::GenericGF& field) {
 	out << "GF(" << field.size() << ',' << field.generatorBase() << ')';
@@ -469,3 +471,58 @@ TEST(ReedSolomonTest, Aztec)
 	TestEncodeDecodeRandom(GenericGF::AztecData10(), 768, 255);
 	TestEncodeDecodeRandom(GenericGF::AztecData12(), 3072, 1023);
 }
+
+TEST(ReedSolomonTest, NoMiscorrection)
+{
+	// With more errors than correctable, decoding must either fail or result in a valid code word. The small AztecParam
+	// field makes it likely to find a (wrong) code word nearby.
+	const auto& field = GenericGF::AztecParam();
+	PseudoRandom random(0x12345678);
+	int decoded = 0;
+	for (int i = 0; i < 2000; ++i) {
+		const int numECCodeWords = 2 * random.next(2, 4);
+		std::vector<int> message(random.next(numECCodeWords + 1, field.size() - 1));
+		for (auto& v : message)
+			v = random.next(0, field.size() - 1);
+		ReedSolomonEncode(field, message, numECCodeWords);
+		Corrupt(message, numECCodeWords / 2 + 1 + random.next(0, 2), random, field.size());
+
+		if (ReedSolomonDecode(field, message, numECCodeWords)) {
+			auto reencoded = message;
+			ReedSolomonEncode(field, reencoded, numECCodeWords);
+			EXPECT_EQ(reencoded, message);
+			++decoded;
+		}
+	}
+	EXPECT_GT(decoded, 0);
+}
+
+TEST(ReedSolomonTest, Concurrent)
+{
+	// the encoders share the cached generators, encoding from several threads has to give the same code words
+	const auto& field = GenericGF::QRCodeField256();
+	PseudoRandom random(0x12345678);
+	std::vector<std::vector<int>> messages(200);
+	for (auto& m : messages) {
+		m.resize(random.next(70, 150));
+		for (auto& v : m)
+			v = random.next(0, field.size() - 1);
+	}
+	auto numECCodeWords = [](int i) { return 7 + i % 61; };
+
+	std::vector<std::vector<std::vector<int>>> encoded(4, messages);
+	std::vector<std::thread> threads;
+	for (auto& e : encoded)
+		threads.emplace_back([&] {
+			for (int i = 0; i < Size(e); ++i)
+				ReedSolomonEncode(field, e[i], numECCodeWords(i));
+		});
+	for (auto& t : threads)
+		t.join();
+
+	for (int i = 0; i < Size(messages); ++i) {
+		ReedSolomonEncode(field, messages[i], numECCodeWords(i));
+		for (auto& e : encoded)
+			EXPECT_EQ(e[i], messages[i]);
+	}
+}
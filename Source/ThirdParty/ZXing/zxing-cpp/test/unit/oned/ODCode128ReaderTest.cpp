@@ -3,9 +3,11 @@
 */
 // SPDX-License-Identifier: Apache-2.0
 
+#include "oned/ODCode128Patterns.h"
 #include "oned/ODCode128Reader.h"
 
 #include "DecodeHints.h"
+#include "PseudoRandom.h"
 #include "Result.h"
 
 #include "gtest/gtest.h"
@@ -109,3 +111,29 @@ TEST(ODCode128ReaderTest, ReaderInit)
 		EXPECT_EQ(result.text(), "92");
 	}
 }
+
+TEST(ODCode128ReaderTest, LookupDigit)
+{
+	const auto table = RowReader::DigitTable<6>(Code128::CODE_PATTERNS);
+	PseudoRandom random(0x12345678);
+	int hits = 0;
+	for (int n = 0; n < 20; ++n)
+		for (int i = 0; i < Size(Code128::CODE_PATTERNS); ++i) {
+			// print with 3 pixels per module and let every edge jitter by up to a pixel
+			PatternRow row(1 + 6 + 1);
+			for (int j = 0; j < 6; ++j)
+				row[1 + j] = narrow_cast<PatternType>(3 * Code128::CODE_PATTERNS[i][j] + (n ? random.next(-1, 1) : 0));
+			auto view = PatternView(row).subView(0, 6);
+
+			int code = RowReader::LookupDigit<6, 11>(view, table, 0.25f, 0.7f);
+			if (n == 0) {
+				EXPECT_EQ(code, i);
+			}
+			if (code != -1) {
+				EXPECT_EQ(code, RowReader::DecodeDigit(view, Code128::CODE_PATTERNS, 0.25f, 0.7f));
+				++hits;
+			}
+		}
+	// the fast path has to take care of the majority of all characters
+	EXPECT_GT(hits, 20 * Size(Code128::CODE_PATTERNS) / 2);
+}
@@ -0,0 +1,92 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ReadBarcode.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+
+// DataBarExpanded Stacked with 11 rows (11 + 10 * 3 separators), 1 column (2 data segments) wide
+static const char* const Bitstream =
+	"01010101111011111110111111110000101100100000010100010"
+	"00001010000100000001000000001010010011011111101010000"
+	"00000101010101010101010101010101010101010101010100000"
+	"00001000001110100010100001010101001110000101100110000"
+	"10100111110001011101011110000000010001111010011000101"
+	"00001000001110100010100001010101001110000101100110000"
+	"00000101010101010101010101010101010101010101010100000"
+	"00000001110100100001010000001010010101100111000110000"
+	"01011110001011011110001111110000101010011000111000010"
+	"00000001110100100001010000001010010101100111000110000"
+	"00000101010101010101010101010101010101010101010100000"
+	"00000110001111101110100001010100001110001110111010000"
+	"10101001110000010001011110000001110001110001000100101"
+	"00000110001111101110100001010100001110001110111010000"
+	"00000101010101010101010101010101010101010101010100000"
+	"00001000011011000101010000101010010011100010001100000"
+	"01000111100100111010001111000000101100011101110010010"
+	"00001000011011000101010000101010010011100010001100000"
+	"00000101010101010101010101010101010101010101010100000"
+	"00001000110001110110100000000100001011110100001000000"
+	"10100111001110001001011111111001110100001011110111101"
+	"00001000110001110110100000000100001011110100001000000"
+	"00000101010101010101010101010101010101010101010100000"
+	"00000010011101111101010010101010010100110000100000000"
+	"01011101100010000010001100000000101011001111011110010"
+	"00000010011101111101010010101010010100110000100000000"
+	"00000101010101010101010101010101010101010101010100000"
+	"00000100010111101110100000101010001100000110011010000"
+	"10111011101000010001011111000000110011111001100101101"
+	"00000100010111101110100000101010001100000110011010000"
+	"00000101010101010101010101010101010101010101010100000"
+	"00000011000110001001000000010101010000011110011010000"
+	"01011100111001110110011111100000101111100001100101010"
+	"00000011000110001001000000010101010000011110011010000"
+	"00000101010101010101010101010101010101010101010100000"
+	"00001011100010001110100000000010001011111010001100000"
+	"10100100011101110001011111111100110100000101110011101"
+	"00001011100010001110100000000010001011111010001100000"
+	"00000101010101010101010101010101010101010101010100000"
+	"00001000111010000101000101010101010100001011000110000"
+	"01000111000101111010011000000000101011110100111000010";
+
+// draws the stacked symbol at x/y with 2 pixels per module, rotated by 180° if upsideDown
+static void Draw(std::vector<uint8_t>& img, int width, int x0, int y0, bool upsideDown)
+{
+	const std::string bits = Bitstream;
+	const int w = 53, h = Size(bits) / w;
+	for (int y = 0; y < 2 * h; ++y)
+		for (int x = 0; x < 2 * w; ++x) {
+			int u = x / 2, v = y / 2;
+			if (upsideDown)
+				u = w - 1 - u, v = h - 1 - v;
+			if (bits[v * w + u] == '1')
+				img[(y0 + y) * width + x0 + x] = 0;
+		}
+}
+
+TEST(ODDataBarExpandedReaderTest, MultipleStackedSymbols)
+{
+	// two symbols next to each other on the same rows, the right one upside down
+	const int width = 260, height = 120;
+	std::vector<uint8_t> img(width * height, 0xFF);
+	Draw(img, width, 20, 10, false);
+	Draw(img, width, 150, 10, true);
+
+	auto hints = DecodeHints().setFormats(BarcodeFormat::DataBarExpanded).setTryRotate(false).setTryHarder(true);
+	auto results = ReadBarcodes({img.data(), width, height, ImageFormat::Lum}, hints);
+
+	ASSERT_EQ(results.size(), 2);
+	for (auto& r : results)
+		EXPECT_EQ(r.text(TextMode::HRI), "(91)12345678901234567890123456789012345678901234567890123456789012345678");
+	EXPECT_EQ(results[0].orientation(), 0);
+	EXPECT_LT(results[0].position().topRight().x, 150);
+	EXPECT_EQ(results[1].orientation(), 180);
+	EXPECT_GT(results[1].position().topRight().x, 150);
+}
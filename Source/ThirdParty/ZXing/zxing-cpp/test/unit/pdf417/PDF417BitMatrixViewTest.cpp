@@ -0,0 +1,51 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "PseudoRandom.h"
+#include "pdf417/PDFBitMatrixView.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+using namespace ZXing::Pdf417;
+
+static void ExpectEqual(const BitMatrixView& view, const BitMatrix& bits)
+{
+	ASSERT_EQ(view.width(), bits.width());
+	ASSERT_EQ(view.height(), bits.height());
+	for (int y = 0; y < bits.height(); ++y)
+		for (int x = 0; x < bits.width(); ++x)
+			EXPECT_EQ(view.get(x, y), bits.get(x, y)) << x << "," << y;
+}
+
+TEST(PDF417BitMatrixViewTest, Rotation)
+{
+	PseudoRandom random(0x12345678);
+	BitMatrix bits(7, 5);
+	for (int y = 0; y < bits.height(); ++y)
+		for (int x = 0; x < bits.width(); ++x)
+			bits.set(x, y, random.next(0, 1));
+
+	auto rotated = bits.copy();
+	for (int rotation : {0, 90, 180, 270}) {
+		ExpectEqual(BitMatrixView(bits, rotation), rotated);
+		rotated.rotate90();
+	}
+}
+
+TEST(PDF417BitMatrixViewTest, Outside)
+{
+	BitMatrix bits(3, 2);
+	bits.setRegion(0, 0, 3, 2);
+	for (int rotation : {0, 90, 180, 270}) {
+		BitMatrixView view(bits, rotation);
+		EXPECT_TRUE(view.get(0, 0));
+		EXPECT_FALSE(view.get(-1, 0));
+		EXPECT_FALSE(view.get(0, -1));
+		EXPECT_FALSE(view.get(view.width(), 0));
+		EXPECT_FALSE(view.get(0, view.height()));
+	}
+}
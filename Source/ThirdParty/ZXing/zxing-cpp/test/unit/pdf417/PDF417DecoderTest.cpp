@@ -327,6 +327,19 @@ TEST(PDF417DecoderTest, NumericCompaction)
 		L"12345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
 }
 
+TEST(PDF417DecoderTest, NumericCompactionLeadingZeros)
+{
+	// example of ISO/IEC 15438:2015 5.4.4.3
+	EXPECT_EQ(decode({ 8, 902, 1, 624, 434, 632, 282, 200 }), L"000213298174000");
+
+	// 15 codewords (44 digits) followed by 1 codeword (2 digits)
+	EXPECT_EQ(decode({ 18, 902, 491, 81, 137, 450, 302, 67, 15, 174, 492, 862, 667, 475, 869, 12, 434, 100 }),
+		L"1234567890123456789012345678901234567890123400");
+
+	// a value without the leading 1 is invalid
+	EXPECT_FALSE(valid({ 4, 902, 3, 0 }));
+}
+
 TEST(PDF417DecoderTest, CompactionCombos)
 {
 	// Text, Byte, Numeric, Text
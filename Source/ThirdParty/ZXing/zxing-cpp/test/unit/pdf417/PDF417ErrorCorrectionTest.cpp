@@ -100,3 +100,38 @@ TEST(PDF417ErrorCorrectionTest, TooManyErrors)
 	int nbError = 0;
 	EXPECT_FALSE(DecodeErrorCorrection(received, ECC_BYTES, std::vector<int>(), nbError));
 }
+
+static std::vector<int> Erase(std::vector<int>& received, int howMany, PseudoRandom& random)
+{
+	std::vector<int> erasures;
+	while (Size(erasures) < howMany) {
+		int location = random.next(0, Size(received) - 1);
+		if (!Contains(erasures, location)) {
+			erasures.push_back(location);
+			received[location] = 0;
+		}
+	}
+	return erasures;
+}
+
+TEST(PDF417ErrorCorrectionTest, MaxErasures)
+{
+	PseudoRandom random(0x12345678);
+	for (int testIterations = 0; testIterations < 100; testIterations++) {
+		std::vector<int> received(PDF417_TEST_WITH_EC, PDF417_TEST_WITH_EC + Size(PDF417_TEST_WITH_EC));
+		auto erasures = Erase(received, MAX_ERASURES, random);
+		CheckDecode(received, erasures);
+	}
+}
+
+TEST(PDF417ErrorCorrectionTest, ErasuresAndErrors)
+{
+	PseudoRandom random(0x12345678);
+	for (int numErasures = 0; numErasures <= MAX_ERASURES; numErasures += 4) {
+		std::vector<int> received(PDF417_TEST_WITH_EC, PDF417_TEST_WITH_EC + Size(PDF417_TEST_WITH_EC));
+		auto erasures = Erase(received, numErasures, random);
+		// errors at erased positions are covered by the erasures
+		Corrupt(received, (ECC_BYTES - numErasures) / 2, random, 929);
+		CheckDecode(received, erasures);
+	}
+}
@@ -7,6 +7,7 @@
 #include "BitMatrix.h"
 #include "BitMatrixIO.h"
 #include "ByteArray.h"
+#include "MultiFormatWriter.h"
 #include "qrcode/QRBitMatrixParser.h"
 #include "qrcode/QRFormatInformation.h"
 #include "qrcode/QRVersion.h"
@@ -71,3 +72,25 @@ TEST(QRBitMatrixParserTest, MQRCodeM3M)
 	EXPECT_EQ(0x0, codewords[8]);
 	EXPECT_EQ(0x89, codewords[9]);
 }
+
+TEST(QRBitMatrixParserTest, QRCodeMirrored)
+{
+	// version 1, 6 (no version information), 7 and 40
+	for (int length : {10, 160, 200, 4200}) {
+		const auto bitMatrix = MultiFormatWriter(BarcodeFormat::QRCode).setMargin(0).encode(std::string(length, 'A'), 0, 0);
+		BitMatrix mirrored(bitMatrix.width(), bitMatrix.height());
+		for (int y = 0; y < bitMatrix.height(); ++y)
+			for (int x = 0; x < bitMatrix.width(); ++x)
+				mirrored.set(y, x, bitMatrix.get(x, y));
+
+		const auto version = ReadVersion(bitMatrix);
+		ASSERT_NE(version, nullptr);
+		const auto format = ReadFormatInformation(bitMatrix, false);
+		const auto codewords = ReadCodewords(bitMatrix, *version, format);
+		EXPECT_EQ(version->totalCodewords(), codewords.size());
+
+		const auto mirroredFormat = ReadFormatInformation(mirrored, false);
+		EXPECT_TRUE(mirroredFormat.isMirrored);
+		EXPECT_EQ(codewords, ReadCodewords(mirrored, *version, mirroredFormat));
+	}
+}
@@ -0,0 +1,183 @@
+/*
+* Copyright 2026 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "MultiFormatWriter.h"
+#include "PseudoRandom.h"
+#include "ReadBarcode.h"
+#include "qrcode/QRDetector.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <map>
+
+using namespace ZXing;
+using namespace ZXing::QRCode;
+
+static void Draw(BitMatrix& image, const std::string& text, int left, int top, int size)
+{
+	auto bits = MultiFormatWriter(BarcodeFormat::QRCode).setMargin(0).encode(text, size, size);
+	for (int y = 0; y < bits.height(); ++y)
+		for (int x = 0; x < bits.width(); ++x)
+			if (bits.get(x, y))
+				image.set(left + x, top + y);
+}
+
+static BitMatrix Sheet()
+{
+	// a sheet of codes of different sizes, some of them crossing the borders between the scanning bands
+	BitMatrix image(1300, 1500);
+	for (int i = 0; i < 12; ++i)
+		Draw(image, "label " + std::to_string(i), 20 + (i % 4) * 310, 15 + (i / 4) * 490 + (i % 3) * 37, 120 + 40 * (i % 4));
+	return image;
+}
+
+// The exhaustive enumeration of all triples GenerateFinderPatternSets used before the spatial pruning. The patterns
+// have to be sorted by size already (GenerateFinderPatternSets does that in place), std::sort is not stable.
+static FinderPatternSets ReferenceFinderPatternSets(const FinderPatterns& patterns)
+{
+	auto sets            = std::multimap<double, FinderPatternSet>();
+	auto squaredDistance = [](const auto* a, const auto* b) {
+		return dot((*a - *b), (*a - *b)) * std::pow(double(b->size) / a->size, 2);
+	};
+	const double cosUpper = std::cos(45. / 180 * 3.1415);
+	const double cosLower = std::cos(135. / 180 * 3.1415);
+
+	int nbPatterns = Size(patterns);
+	for (int i = 0; i < nbPatterns - 2; i++) {
+		for (int j = i + 1; j < nbPatterns - 1; j++) {
+			for (int k = j + 1; k < nbPatterns - 0; k++) {
+				const auto* a = &patterns[i];
+				const auto* b = &patterns[j];
+				const auto* c = &patterns[k];
+				if (c->size > a->size * 2)
+					break;
+
+				auto distAB2 = squaredDistance(a, b);
+				auto distBC2 = squaredDistance(b, c);
+				auto distAC2 = squaredDistance(a, c);
+
+				if (distBC2 >= distAB2 && distBC2 >= distAC2) {
+					std::swap(a, b);
+					std::swap(distBC2, distAC2);
+				} else if (distAB2 >= distAC2 && distAB2 >= distBC2) {
+					std::swap(b, c);
+					std::swap(distAB2, distAC2);
+				}
+
+				auto distAB = std::sqrt(distAB2);
+				auto distBC = std::sqrt(distBC2);
+
+				if (distAB > 2 * distBC || distBC > 2 * distAB)
+					continue;
+
+				if (auto moduleCount = (distAB + distBC) / (2 * (a->size + b->size + c->size) / (3 * 7.f)) + 7;
+					moduleCount < 21 * 0.9 || moduleCount > 177 * 1.5)
+					continue;
+
+				auto cosAB_BC = (distAB2 + distBC2 - distAC2) / (2 * distAB * distBC);
+				if (std::isnan(cosAB_BC) || cosAB_BC > cosUpper || cosAB_BC < cosLower)
+					continue;
+
+				double d = (std::abs(distAC2 - 2 * distAB2) + std::abs(distAC2 - 2 * distBC2));
+
+				if (cross(*c - *b, *a - *b) < 0)
+					std::swap(a, c);
+
+				const auto setSizeLimit = 256;
+				if (sets.size() < setSizeLimit || sets.crbegin()->first > d) {
+					sets.emplace(d, FinderPatternSet{*a, *b, *c});
+					if (sets.size() > setSizeLimit)
+						sets.erase(std::prev(sets.end()));
+				}
+			}
+		}
+	}
+
+	FinderPatternSets res;
+	for (auto& [d, s] : sets)
+		res.push_back(s);
+	return res;
+}
+
+static void ExpectSameSets(FinderPatterns patterns)
+{
+	auto sets = GenerateFinderPatternSets(patterns);
+	auto expected = ReferenceFinderPatternSets(patterns);
+
+	ASSERT_EQ(sets.size(), expected.size());
+	for (size_t i = 0; i < sets.size(); ++i)
+		for (auto [p, e] : {std::pair(sets[i].bl, expected[i].bl), {sets[i].tl, expected[i].tl}, {sets[i].tr, expected[i].tr}}) {
+			EXPECT_EQ(PointF(p), PointF(e)) << "set " << i;
+			EXPECT_EQ(p.size, e.size) << "set " << i;
+		}
+}
+
+TEST(QRDetectorTest, FindFinderPatternsParallel)
+{
+	auto image = Sheet();
+
+	for (bool tryHarder : {true, false}) {
+		auto expected = FindFinderPatterns(image, tryHarder);
+		EXPECT_GE(expected.size(), 3 * 12);
+
+		for (int numThreads : {0, 2, 3, 7}) {
+			auto res = FindFinderPatterns(image, tryHarder, numThreads);
+			ASSERT_EQ(res.size(), expected.size());
+			for (size_t i = 0; i < res.size(); ++i) {
+				EXPECT_EQ(PointF(res[i]), PointF(expected[i]));
+				EXPECT_EQ(res[i].size, expected[i].size);
+			}
+		}
+	}
+}
+
+TEST(QRDetectorTest, GenerateFinderPatternSets)
+{
+	auto image = Sheet();
+	auto patterns = FindFinderPatterns(image, true);
+	ExpectSameSets(patterns);
+	auto sets = GenerateFinderPatternSets(patterns);
+
+	// the finder patterns of every symbol are found as a set
+	int symbols = 0;
+	for (const auto& set : sets)
+		symbols += std::abs(distance(set.bl, set.tl) - distance(set.tl, set.tr)) < 2;
+	EXPECT_GE(symbols, 12);
+
+	std::vector<uint8_t> lum(image.width() * image.height());
+	for (int y = 0; y < image.height(); ++y)
+		for (int x = 0; x < image.width(); ++x)
+			lum[y * image.width() + x] = image.get(x, y) ? 0 : 0xFF;
+
+	auto results = ReadBarcodes({lum.data(), image.width(), image.height(), ImageFormat::Lum},
+								DecodeHints().setFormats(BarcodeFormat::QRCode).setTryRotate(false).setTryDownscale(false));
+	EXPECT_EQ(results.size(), 12);
+}
+
+TEST(QRDetectorTest, GenerateFinderPatternSetsRandom)
+{
+	// symbols of random size, position and rotation between random noise patterns, many of the same size
+	PseudoRandom random(0x12345678);
+	for (int n = 0; n < 20; ++n) {
+		FinderPatterns patterns;
+		for (int i = 0, symbols = random.next(1, 15); i < symbols; ++i) {
+			int moduleSize = random.next(1, 8), dim = random.next(21, 177);
+			PointF tl(random.next(0, 3000), random.next(0, 3000));
+			double angle = random.next(0, 359) / 180. * 3.1415;
+			PointF right = double((dim - 7) * moduleSize) * PointF(std::cos(angle), std::sin(angle));
+			PointF down(-right.y, right.x);
+			for (auto p : {tl, tl + right, tl + down})
+				patterns.push_back({p + PointF(random.next(-3, 3), random.next(-3, 3)), 7 * moduleSize + random.next(-1, 1)});
+		}
+		for (int i = 0, noise = random.next(0, 60); i < noise; ++i)
+			patterns.push_back({PointF(random.next(0, 3000), random.next(0, 3000)), random.next(7, 56)});
+
+		ExpectSameSets(patterns);
+	}
+}